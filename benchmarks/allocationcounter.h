@@ -0,0 +1,26 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocations made by the process so far. With glibc this counts malloc, calloc and
+// realloc, which also covers Qt's containers; elsewhere only operator new is seen.
+std::size_t allocationCount();
+
+// Call after the timed loop. Reports items and bytes per second plus the average number of
+// allocations per item since `allocationsBefore`.
+inline void reportPerItem(benchmark::State& state, std::size_t allocationsBefore,
+                          std::int64_t itemsPerIteration, std::int64_t bytesPerIteration = 0) {
+    std::int64_t items = state.iterations() * itemsPerIteration;
+    state.SetItemsProcessed(items);
+    if (bytesPerIteration > 0)
+        state.SetBytesProcessed(state.iterations() * bytesPerIteration);
+    if (items > 0)
+        state.counters["allocs_per_item"] =
+            static_cast<double>(allocationCount() - allocationsBefore) / items;
+}
+
+#endif // ALLOCATIONCOUNTER_H
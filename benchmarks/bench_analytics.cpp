@@ -0,0 +1,216 @@
+#include "benchmarkdata.h"
+#include "models/employee.h"
+#include "models/employeecolumns.h"
+#include "models/managerhierarchy.h"
+#include "models/salarydistribution.h"
+#include "models/salarygrade.h"
+
+#include <QHash>
+#include <QList>
+#include <QMultiHash>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+
+#define SCAN_SIZES RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)
+
+namespace {
+
+constexpr int GradeCount = 12;
+
+// Decoded once per size; only the scans are timed
+const QList<Employee>& sampleEmployees(int count) {
+    static std::map<int, QList<Employee>> cache;
+    QList<Employee>& employees = cache[count];
+    if (employees.isEmpty()) {
+        employees.reserve(count);
+        for (int i = 0; i < count; ++i)
+            employees.append(Employee::fromJson(sampleEmployeeJson(i)));
+    }
+    return employees;
+}
+
+QHash<QString, double> salaryByGradeId() {
+    QHash<QString, double> salaries;
+    for (int i = 0; i < GradeCount; ++i) {
+        SalaryGrade grade = SalaryGrade::fromJson(sampleSalaryGradeJson(i));
+        salaries.insert(grade.id, grade.baseSalary);
+    }
+    return salaries;
+}
+
+// Each sample employee's base salary, the input the statistics kernels see
+QList<double> sampleSalaries(int count) {
+    QHash<QString, double> salaries = salaryByGradeId();
+    QList<double> values;
+    values.reserve(count);
+    for (const Employee& employee : sampleEmployees(count))
+        values.append(salaries.value(employee.salaryGradeId));
+    return values;
+}
+
+} // namespace
+
+// ============================================================================
+// Aggregate Scan Benchmarks
+// ============================================================================
+
+// Headcount per department the way it has to be done over the rows
+static void BM_CountByDepartmentRows(benchmark::State& state) {
+    const QList<Employee>& employees = sampleEmployees(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        QHash<QString, int> counts;
+        for (const Employee& employee : employees)
+            ++counts[employee.departmentId];
+        benchmark::DoNotOptimize(counts);
+    }
+    state.SetItemsProcessed(state.iterations() * employees.size());
+}
+BENCHMARK(BM_CountByDepartmentRows)->SCAN_SIZES;
+
+static void BM_CountByDepartmentColumns(benchmark::State& state) {
+    EmployeeColumns columns;
+    for (const Employee& employee : sampleEmployees(static_cast<int>(state.range(0))))
+        columns.insert(employee);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(columns.countByDepartment());
+    state.SetItemsProcessed(state.iterations() * columns.size());
+}
+BENCHMARK(BM_CountByDepartmentColumns)->SCAN_SIZES;
+
+// Base salary cost per department, joining each employee to its grade
+static void BM_SalaryByDepartmentRows(benchmark::State& state) {
+    const QList<Employee>& employees = sampleEmployees(static_cast<int>(state.range(0)));
+    QHash<QString, double> salaries = salaryByGradeId();
+    for (auto _ : state) {
+        QHash<QString, double> sums;
+        for (const Employee& employee : employees)
+            sums[employee.departmentId] += salaries.value(employee.salaryGradeId);
+        benchmark::DoNotOptimize(sums);
+    }
+    state.SetItemsProcessed(state.iterations() * employees.size());
+}
+BENCHMARK(BM_SalaryByDepartmentRows)->SCAN_SIZES;
+
+static void BM_SalaryByDepartmentColumns(benchmark::State& state) {
+    EmployeeColumns columns;
+    for (const Employee& employee : sampleEmployees(static_cast<int>(state.range(0))))
+        columns.insert(employee);
+    QHash<QString, double> salaries = salaryByGradeId();
+    QList<double> valueByGrade(columns.gradeIds().size());
+    for (int grade = 0; grade < valueByGrade.size(); ++grade)
+        valueByGrade[grade] = salaries.value(columns.gradeIds().at(grade).toString());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(columns.sumByDepartment(valueByGrade));
+    state.SetItemsProcessed(state.iterations() * columns.size());
+}
+BENCHMARK(BM_SalaryByDepartmentColumns)->SCAN_SIZES;
+
+static void BM_HiredBetweenColumns(benchmark::State& state) {
+    EmployeeColumns columns;
+    for (const Employee& employee : sampleEmployees(static_cast<int>(state.range(0))))
+        columns.insert(employee);
+    const qint64 from = QDateTime(QDate(2019, 1, 1), QTime(0, 0)).toMSecsSinceEpoch();
+    const qint64 to = QDateTime(QDate(2020, 1, 1), QTime(0, 0)).toMSecsSinceEpoch();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(columns.countHiredBetween(from, to, true));
+    state.SetItemsProcessed(state.iterations() * columns.size());
+}
+BENCHMARK(BM_HiredBetweenColumns)->SCAN_SIZES;
+
+// ============================================================================
+// Salary Distribution Benchmarks
+// ============================================================================
+
+// Both percentile variants reorder their input, so each works on a fresh copy
+static void BM_SalaryPercentilesSort(benchmark::State& state) {
+    const QList<double> salaries = sampleSalaries(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        QList<double> values = salaries;
+        std::sort(values.begin(), values.end());
+        const qsizetype last = values.size() - 1;
+        benchmark::DoNotOptimize(values.at(last / 10));
+        benchmark::DoNotOptimize(values.at(last / 2));
+        benchmark::DoNotOptimize(values.at(last * 9 / 10));
+    }
+    state.SetItemsProcessed(state.iterations() * salaries.size());
+}
+BENCHMARK(BM_SalaryPercentilesSort)->SCAN_SIZES;
+
+static void BM_SalaryPercentilesSelection(benchmark::State& state) {
+    const QList<double> salaries = sampleSalaries(static_cast<int>(state.range(0)));
+    const double fractions[] = {0.1, 0.5, 0.9};
+    double results[3];
+    for (auto _ : state) {
+        QList<double> values = salaries;
+        SalaryDistribution::percentiles(values.data(), values.size(), fractions, 3, results);
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetItemsProcessed(state.iterations() * salaries.size());
+}
+BENCHMARK(BM_SalaryPercentilesSelection)->SCAN_SIZES;
+
+// Everything SalaryStatisticsModel shows for one group
+static void BM_SalaryDistribution(benchmark::State& state) {
+    const QList<double> salaries = sampleSalaries(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        QList<double> values = salaries;
+        SalaryDistribution distribution = SalaryDistribution::of(values.data(), values.size());
+        benchmark::DoNotOptimize(distribution);
+        benchmark::DoNotOptimize(SalaryDistribution::histogram(
+            salaries.constData(), salaries.size(), distribution.min, distribution.max, 10));
+    }
+    state.SetItemsProcessed(state.iterations() * salaries.size());
+}
+BENCHMARK(BM_SalaryDistribution)->SCAN_SIZES;
+
+// ============================================================================
+// Reporting Chain Benchmarks
+// ============================================================================
+
+// The sample employees form a tree with eight reports per manager; emp-1 heads about an
+// eighth of it
+static void BM_ReportsUnderDirectReports(benchmark::State& state) {
+    QMultiHash<QString, QString> reportIds;
+    for (const Employee& employee : sampleEmployees(static_cast<int>(state.range(0)))) {
+        if (employee.managerId != employee.id)
+            reportIds.insert(employee.managerId, employee.id);
+    }
+    for (auto _ : state) {
+        QStringList reports = reportIds.values("emp-1");
+        for (qsizetype i = 0; i < reports.size(); ++i)
+            reports.append(reportIds.values(reports.at(i)));
+        benchmark::DoNotOptimize(reports);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 8);
+}
+BENCHMARK(BM_ReportsUnderDirectReports)->SCAN_SIZES;
+
+static void BM_ReportsUnderHierarchy(benchmark::State& state) {
+    ManagerHierarchy hierarchy;
+    for (const Employee& employee : sampleEmployees(static_cast<int>(state.range(0))))
+        hierarchy.setManager(employee.id, employee.managerId);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(hierarchy.reportsUnder("emp-1"));
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 8);
+}
+BENCHMARK(BM_ReportsUnderHierarchy)->SCAN_SIZES;
+
+// One edit followed by queries, the way the UI interleaves them; the queries walk the links
+// instead of relabeling
+static void BM_HierarchyEditThenQuery(benchmark::State& state) {
+    ManagerHierarchy hierarchy;
+    for (const Employee& employee : sampleEmployees(static_cast<int>(state.range(0))))
+        hierarchy.setManager(employee.id, employee.managerId);
+    bool flip = false;
+    for (auto _ : state) {
+        hierarchy.setManager("emp-9", (flip = !flip) ? "emp-2" : "emp-1");
+        benchmark::DoNotOptimize(hierarchy.wouldCreateCycle("emp-1", "emp-72"));
+        benchmark::DoNotOptimize(hierarchy.isAbove("emp-1", "emp-72"));
+        benchmark::DoNotOptimize(hierarchy.reportCountUnder("emp-2"));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HierarchyEditThenQuery)->SCAN_SIZES;
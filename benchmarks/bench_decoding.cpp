@@ -0,0 +1,86 @@
+#include "allocationcounter.h"
+#include "api/jsonarrayreader.h"
+#include "benchmarkdata.h"
+#include "models/department.h"
+#include "models/employee.h"
+#include "models/salarygrade.h"
+
+#include <QJsonArray>
+#include <QList>
+
+#include <benchmark/benchmark.h>
+
+// List sizes from a small company up to well past what the API is expected to serve
+#define LIST_SIZES RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond)
+
+namespace {
+
+// What ApiClient does for a list response once the whole body is in: parse the document,
+// then decode element by element
+template <typename T>
+QList<T> decodeDocument(const QByteArray& payload) {
+    QJsonArray array = QJsonDocument::fromJson(payload).array();
+    QList<T> items;
+    items.reserve(array.size());
+    for (const QJsonValue& value : array)
+        items.append(T::fromJson(value.toObject()));
+    return items;
+}
+
+// The streaming path ApiClient takes for employees, fed in network-sized chunks
+QList<Employee> decodeStream(const QByteArray& payload, int chunkSize) {
+    JsonArrayReader reader;
+    QList<Employee> employees;
+    QJsonObject element;
+    for (qsizetype offset = 0; offset < payload.size(); offset += chunkSize) {
+        reader.addData(payload.mid(offset, chunkSize));
+        while (reader.readNext(element))
+            employees.append(Employee::fromJson(element));
+    }
+    return employees;
+}
+
+template <typename T, typename MakeEntity>
+void runDocumentDecode(benchmark::State& state, const char* kind, MakeEntity makeEntity) {
+    const int count = static_cast<int>(state.range(0));
+    const QByteArray& payload = listPayload(kind, count, makeEntity);
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        QList<T> items = decodeDocument<T>(payload);
+        benchmark::DoNotOptimize(items.data());
+    }
+    reportPerItem(state, allocationsBefore, count, payload.size());
+}
+
+} // namespace
+
+// ============================================================================
+// List Decoding Benchmarks
+// ============================================================================
+
+static void BM_DecodeEmployeeList(benchmark::State& state) {
+    runDocumentDecode<Employee>(state, "employees", sampleEmployeeJson);
+}
+BENCHMARK(BM_DecodeEmployeeList)->LIST_SIZES;
+
+static void BM_StreamEmployeeList(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const QByteArray& payload = listPayload("employees", count, sampleEmployeeJson);
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        QList<Employee> employees = decodeStream(payload, 16 * 1024);
+        benchmark::DoNotOptimize(employees.data());
+    }
+    reportPerItem(state, allocationsBefore, count, payload.size());
+}
+BENCHMARK(BM_StreamEmployeeList)->LIST_SIZES;
+
+static void BM_DecodeDepartmentList(benchmark::State& state) {
+    runDocumentDecode<Department>(state, "departments", sampleDepartmentJson);
+}
+BENCHMARK(BM_DecodeDepartmentList)->LIST_SIZES;
+
+static void BM_DecodeSalaryGradeList(benchmark::State& state) {
+    runDocumentDecode<SalaryGrade>(state, "salary-grades", sampleSalaryGradeJson);
+}
+BENCHMARK(BM_DecodeSalaryGradeList)->LIST_SIZES;
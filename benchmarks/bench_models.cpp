@@ -0,0 +1,129 @@
+#include "allocationcounter.h"
+#include "benchmarkdata.h"
+#include "models/compactemployee.h"
+#include "models/department.h"
+#include "models/employee.h"
+#include "models/isodatetime.h"
+#include "models/salarygrade.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+// ============================================================================
+// Single Entity Benchmarks
+// ============================================================================
+
+static void BM_EmployeeFromJson(benchmark::State& state) {
+    QJsonObject json = sampleEmployeeJson();
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        Employee employee = Employee::fromJson(json);
+        benchmark::DoNotOptimize(employee);
+    }
+    reportPerItem(state, allocationsBefore, 1);
+}
+BENCHMARK(BM_EmployeeFromJson);
+
+static void BM_EmployeeToJson(benchmark::State& state) {
+    Employee employee = Employee::fromJson(sampleEmployeeJson());
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        QJsonObject json = employee.toJson();
+        benchmark::DoNotOptimize(json);
+    }
+    reportPerItem(state, allocationsBefore, 1);
+}
+BENCHMARK(BM_EmployeeToJson);
+
+static void BM_DepartmentRoundTrip(benchmark::State& state) {
+    QJsonObject json = sampleDepartmentJson();
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        Department department = Department::fromJson(json);
+        QJsonObject out = department.toJson();
+        benchmark::DoNotOptimize(out);
+    }
+    reportPerItem(state, allocationsBefore, 1);
+}
+BENCHMARK(BM_DepartmentRoundTrip);
+
+static void BM_SalaryGradeRoundTrip(benchmark::State& state) {
+    QJsonObject json = sampleSalaryGradeJson();
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        SalaryGrade grade = SalaryGrade::fromJson(json);
+        QJsonObject out = grade.toJson();
+        benchmark::DoNotOptimize(out);
+    }
+    reportPerItem(state, allocationsBefore, 1);
+}
+BENCHMARK(BM_SalaryGradeRoundTrip);
+
+// ============================================================================
+// Compact Representation Benchmarks
+// ============================================================================
+
+static void BM_CompactEmployeeFromJson(benchmark::State& state) {
+    QJsonObject json = sampleEmployeeJson();
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        CompactEmployee employee = CompactEmployee::fromEmployee(Employee::fromJson(json));
+        benchmark::DoNotOptimize(employee);
+    }
+    reportPerItem(state, allocationsBefore, 1);
+}
+BENCHMARK(BM_CompactEmployeeFromJson);
+
+// Equal rows are the common case when a refreshed list is diffed against the model
+static void BM_EmployeeEquality(benchmark::State& state) {
+    Employee a = Employee::fromJson(sampleEmployeeJson());
+    Employee b = Employee::fromJson(sampleEmployeeJson());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a == b);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EmployeeEquality);
+
+static void BM_CompactEmployeeEquality(benchmark::State& state) {
+    CompactEmployee a = CompactEmployee::fromEmployee(Employee::fromJson(sampleEmployeeJson()));
+    CompactEmployee b = CompactEmployee::fromEmployee(Employee::fromJson(sampleEmployeeJson()));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a == b);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CompactEmployeeEquality);
+
+// ============================================================================
+// Timestamp Parsing Benchmarks
+// ============================================================================
+
+// The shapes the API sends: UTC with and without a fraction, an explicit offset, and a
+// date-only hire_date
+static const std::array<QString, 4> kTimestamps = {
+    QStringLiteral("2024-11-02T16:03:11Z"),
+    QStringLiteral("2024-11-02T16:03:11.482913Z"),
+    QStringLiteral("2024-11-02T18:03:11+02:00"),
+    QStringLiteral("2019-04-01"),
+};
+
+static void BM_ParseIsoDateTime(benchmark::State& state) {
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        for (const QString& timestamp : kTimestamps)
+            benchmark::DoNotOptimize(parseIsoDateTime(timestamp));
+    }
+    reportPerItem(state, allocationsBefore, kTimestamps.size());
+}
+BENCHMARK(BM_ParseIsoDateTime);
+
+// The baseline the fast path replaces
+static void BM_QtParseIsoDateTime(benchmark::State& state) {
+    std::size_t allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        for (const QString& timestamp : kTimestamps)
+            benchmark::DoNotOptimize(QDateTime::fromString(timestamp, Qt::ISODate));
+    }
+    reportPerItem(state, allocationsBefore, kTimestamps.size());
+}
+BENCHMARK(BM_QtParseIsoDateTime);
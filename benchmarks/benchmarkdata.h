@@ -0,0 +1,66 @@
+#ifndef BENCHMARKDATA_H
+#define BENCHMARKDATA_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+// Entities shaped like what the API returns, with every field the models read filled in
+
+inline QJsonObject sampleEmployeeJson(int index = 0) {
+    QString suffix = QString::number(index);
+    return QJsonObject{{"id", "3f2b8c1e-7a4d-4e9b-9c61-" + suffix.rightJustified(12, '0')},
+                       {"first_name", "Firstname" + suffix},
+                       {"last_name", "Lastname" + suffix},
+                       {"email", "employee" + suffix + "@company.com"},
+                       {"role", "Employee"},
+                       {"active", true},
+                       {"department_id", "dept-" + QString::number(index % 40)},
+                       {"manager_id", "emp-" + QString::number(index / 8)},
+                       {"salary_grade_id", "grade-" + QString::number(index % 12)},
+                       {"hire_date", "2019-04-01T00:00:00Z"},
+                       {"created_at", "2019-03-28T09:15:42Z"},
+                       {"updated_at", "2024-11-02T16:03:11Z"},
+                       {"deleted_at", QJsonValue()}};
+}
+
+inline QJsonObject sampleDepartmentJson(int index = 0) {
+    return QJsonObject{{"id", "dept-" + QString::number(index)},
+                       {"name", "Department " + QString::number(index)},
+                       {"head_id", "emp-" + QString::number(index * 25)},
+                       {"created_at", "2018-01-15T08:00:00Z"},
+                       {"updated_at", "2024-06-30T12:45:00Z"}};
+}
+
+inline QJsonObject sampleSalaryGradeJson(int index = 0) {
+    return QJsonObject{{"id", "grade-" + QString::number(index)},
+                       {"code", "G" + QString::number(index)},
+                       {"base_salary", 42000.0 + index * 2500.0},
+                       {"description", "Salary grade " + QString::number(index)},
+                       {"created_at", "2018-01-15T08:00:00Z"}};
+}
+
+// A JSON array of `count` entities as the list endpoints send it. Built once per size and
+// kept, since the large ones take longer to generate than to decode.
+template <typename MakeEntity>
+const QByteArray& listPayload(const char* kind, int count, MakeEntity makeEntity) {
+    static QHash<QByteArray, QByteArray> payloads;
+    QByteArray key = QByteArray(kind) + '/' + QByteArray::number(count);
+    auto cached = payloads.constFind(key);
+    if (cached != payloads.cend())
+        return *cached;
+
+    QByteArray payload = "[";
+    for (int i = 0; i < count; ++i) {
+        if (i > 0)
+            payload += ',';
+        payload += QJsonDocument(makeEntity(i)).toJson(QJsonDocument::Compact);
+    }
+    payload += ']';
+    return *payloads.insert(key, payload);
+}
+
+#endif // BENCHMARKDATA_H
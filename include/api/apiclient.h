@@ -1,31 +1,56 @@
 #ifndef APICLIENT_H
 #define APICLIENT_H
 
+#include "api/jsonarrayreader.h"
+#include "api/mutationvalidator.h"
+#include "api/requestscheduler.h"
 #include "models/department.h"
 #include "models/employee.h"
 #include "models/salarygrade.h"
 
+#include <QFutureWatcher>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QJsonObject>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
 
 class ApiClient : public QObject {
     Q_OBJECT
 
+    Q_PROPERTY(int coalescedRequests READ coalescedRequests NOTIFY requestStatsChanged)
+    Q_PROPERTY(int mergedRefreshes READ mergedRefreshes NOTIFY requestStatsChanged)
+    Q_PROPERTY(int cacheHits READ cacheHits NOTIFY requestStatsChanged)
+    Q_PROPERTY(int cacheMisses READ cacheMisses NOTIFY requestStatsChanged)
+    Q_PROPERTY(int avoidedRoundTrips READ avoidedRoundTrips NOTIFY requestStatsChanged)
+    Q_PROPERTY(RequestScheduler* scheduler READ scheduler CONSTANT)
+
 public:
+    enum Collection { Departments, Employees, SalaryGrades };
+    Q_ENUM(Collection)
+
     explicit ApiClient(QObject* parent = nullptr);
 
+    // Overrides the API URL from Config; an empty string goes back to it
+    void setApiUrl(const QString& url) { m_apiUrl = url; }
+
+    using Priority = RequestScheduler::Priority;
+
     // Department operations
-    void getDepartments();
+    void getDepartments(Priority priority = RequestScheduler::Interactive);
     void createDepartment(const QString& name, const QString& headId = QString());
     void updateDepartment(const QString& id, const QString& name,
                           const QString& headId = QString());
     void deleteDepartment(const QString& id);
 
-    // Employee operations
-    void getEmployees(bool includeInactive = false);
+    // Employee operations. Creates and updates the local data proves invalid (a taken email,
+    // an unknown department, manager or grade) fail through operationCompleted() without
+    // being sent; see MutationValidator.
+    void getEmployees(bool includeInactive = false,
+                      Priority priority = RequestScheduler::Interactive);
     void createEmployee(const QString& firstName, const QString& lastName, const QString& email,
                         const QString& role = QString(), const QString& deptId = QString(),
                         const QString& managerId = QString(), const QString& gradeId = QString());
@@ -33,28 +58,164 @@ public:
     void deleteEmployee(const QString& id);
 
     // Salary Grade operations
-    void getSalaryGrades();
+    void getSalaryGrades(Priority priority = RequestScheduler::Interactive);
     void createSalaryGrade(const QString& code, double baseSalary,
                            const QString& description = QString());
     void updateSalaryGrade(const QString& id, const QString& code, double baseSalary,
                            const QString& description = QString());
     void deleteSalaryGrade(const QString& id);
 
+    // One step of a batch. `undoData` is the PUT body that restores the entity should the
+    // batch be rolled back; a POST is undone by deleting what it created. DELETEs and
+    // steps without undo data stay as they are.
+    struct Mutation {
+        QString method; // "POST", "PUT" or "DELETE"
+        Collection collection = Employees;
+        QString id;
+        QJsonObject data;
+        QJsonObject undoData;
+    };
+
+    // Sends `mutations` with at most BatchConcurrency of them in flight and reports a single
+    // result through batchFinished() and operationCompleted(). Nothing more is sent after
+    // the first failure, and the steps that went through are compensated in reverse order.
+    // Returns the id batchFinished() reports.
+    int submitBatch(const QList<Mutation>& mutations);
+
+    // Sends one mutation that reports only through mutationFinished(), for callers that
+    // pace many independent requests themselves. Returns the id mutationFinished() reports.
+    int sendMutation(const Mutation& mutation, Priority priority = RequestScheduler::Interactive);
+
+    // Fetches `collection` in the background once the current burst of mutations has
+    // settled. Repeated requests inside the window collapse into a single GET.
+    void requestRefresh(Collection collection);
+    // Moves fetches of `collection` that are still waiting ahead of background work, e.g.
+    // when a view showing it comes up
+    void prioritize(Collection collection);
+
+    // GETs answered by an identical request that was already in flight
+    int coalescedRequests() const { return m_coalescedRequests; }
+    // Refresh requests folded into a fetch that was already scheduled
+    int mergedRefreshes() const { return m_mergedRefreshes; }
+    // List GETs answered with 304 Not Modified vs. with a full body
+    int cacheHits() const { return m_cacheHits; }
+    int cacheMisses() const { return m_cacheMisses; }
+    // Mutations rejected locally instead of by the server
+    int avoidedRoundTrips() const { return m_avoidedRoundTrips; }
+    // Everything the client sends goes through here; exposes queue and throttling state
+    RequestScheduler* scheduler() const { return m_scheduler; }
+
 signals:
     void departmentsReceived(QList<Department> departments);
     void employeesReceived(QList<Employee> employees);
+    // Employees decoded so far while the list is still downloading
+    void employeesBatchReceived(QList<Employee> employees);
+    // The server confirmed the last delivered list is still current
+    void notModified(ApiClient::Collection collection);
     void salaryGradesReceived(QList<SalaryGrade> grades);
+
+    // Results of single-entity mutations, so callers can patch their copy in place
+    void departmentSaved(Department department);
+    void departmentDeleted(const QString& id);
+    void employeeSaved(Employee employee);
+    void employeeDeleted(const QString& id);
+    void salaryGradeSaved(SalaryGrade grade);
+    void salaryGradeDeleted(const QString& id);
+    // A mutation succeeded but its response could not be applied locally
+    void resyncRequired(ApiClient::Collection collection);
+    void batchFinished(int batchId, bool success, const QString& message);
+    void mutationFinished(int requestId, bool success, const QJsonObject& entity,
+                          const QString& error);
+    void requestStatsChanged();
+
     void operationCompleted(bool success, const QString& message);
     void errorOccurred(const QString& error);
 
 private slots:
     void onReplyFinished();
+    void flushRefreshes();
 
 private:
+    static constexpr int RefreshDebounceMs = 150;
+    static constexpr int BatchConcurrency = 4;
+
+    // Validators of the list last delivered for a collection, and the URL it came from
+    struct Validators {
+        QString url;
+        QByteArray etag;
+        QByteArray lastModified;
+    };
+
     QNetworkAccessManager* m_networkManager;
+    RequestScheduler* m_scheduler;
+    QString m_apiUrl;
+    QHash<Collection, Validators> m_validators;
+    QHash<QString, ScheduledRequest*> m_inFlightGets;
+    QHash<QString, QFutureWatcherBase*> m_decodes;
+
+    struct DecodedEmployees {
+        QList<Employee> employees;
+        QString error;
+    };
+
+    // The reader frames elements as they arrive; each chunk's elements are then decoded on
+    // the pool, and the decoded batches are handed out in the order they were framed
+    struct EmployeeStream {
+        JsonArrayReader reader;
+        QList<Employee> employees;
+        QList<QFutureWatcher<DecodedEmployees>*> decodes;
+        QString error;
+        bool includesInactive = false;
+        bool complete = false;
+    };
+    QHash<int, EmployeeStream> m_employeeStreams;
+    int m_nextStreamId = 1;
+
+    struct Batch {
+        QList<Mutation> queue;
+        QHash<ScheduledRequest*, Mutation> sent;
+        // Steps that undo what went through so far, in the order they were confirmed
+        QList<Mutation> compensations;
+        QSet<Collection> collections;
+        QString error;
+        bool rollingBack = false;
+        int rollbackFailures = 0;
+    };
+    QHash<int, Batch> m_batches;
+    int m_nextBatchId = 1;
+    int m_nextRequestId = 1;
+
+    QTimer* m_refreshTimer;
+    QSet<Collection> m_pendingRefreshes;
+    int m_mutationsInFlight = 0;
+    int m_coalescedRequests = 0;
+    int m_mergedRefreshes = 0;
+    int m_cacheHits = 0;
+    int m_cacheMisses = 0;
+    int m_avoidedRoundTrips = 0;
+    MutationValidator m_mutationValidator;
+
     QString getBaseUrl() const;
-    void sendRequest(const QString& method, const QString& url,
-                     const QJsonObject& data = QJsonObject());
+    void trackForValidation();
+    bool rejectLocally(const QString& id, const QJsonObject& fields);
+    QString urlOf(Collection collection, const QString& id = QString()) const;
+    ScheduledRequest* sendGet(const QString& url, const QString& operation,
+                              Collection collection, Priority priority);
+    void readEmployeeChunk(int streamId, const QByteArray& chunk);
+    void deliverEmployeeBatches(int streamId);
+    void dropEmployeeStream(int streamId);
+    static DecodedEmployees decodeEmployees(const QList<QByteArray>& elements);
+    template <typename T>
+    void decodeInBackground(const QString& operation, Collection collection,
+                            const QByteArray& payload, void (ApiClient::*received)(QList<T>));
+    ScheduledRequest* sendRequest(const QString& method, const QString& url,
+                                  Collection collection, const QString& id = QString(),
+                                  const QJsonObject& data = QJsonObject(),
+                                  Priority priority = RequestScheduler::Interactive);
+    void sendBatchSteps(int batchId);
+    void onBatchReply(int batchId, ScheduledRequest* call, const QJsonDocument& doc);
+    bool applyMutation(const QString& operation, Collection collection, const QString& id,
+                       const QJsonDocument& doc);
 };
 
 #endif // APICLIENT_H
@@ -0,0 +1,144 @@
+#ifndef EMPLOYEEIMPORTER_H
+#define EMPLOYEEIMPORTER_H
+
+#include "api/apiclient.h"
+#include "api/jsonarrayreader.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+#include <memory>
+
+// Bulk-loads employees from a CSV file with a header row or a JSON array of objects. Both
+// use the API field names (first_name, last_name, email, role, hire_date, active), and
+// department / salary_grade may name a department or grade code instead of an id.
+//
+// Rows are read as they are needed, validated and resolved locally, and POSTed at bulk
+// priority with up to Options::window requests outstanding. Every imported row is appended
+// to a journal next to the input, so an interrupted import started again with
+// Options::resume only sends the rows that did not go through. The journal is removed once
+// every row went through.
+class EmployeeImporter : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int DefaultWindow = 8;
+
+    struct Options {
+        int window = DefaultWindow;
+        bool resume = false;
+    };
+
+    // `row` counts data rows from 1, not counting the CSV header
+    struct RowError {
+        int row = 0;
+        QString reason;
+    };
+
+    struct Summary {
+        int imported = 0;
+        int failed = 0;
+        // Rows already imported by an earlier, interrupted run
+        int skipped = 0;
+        qint64 elapsedMs = 0;
+
+        double rowsPerSecond() const;
+    };
+
+    // The lookups are fetched through `client` when the import starts, so it should not
+    // hold cached list validators from earlier fetches; a dedicated client is simplest
+    explicit EmployeeImporter(ApiClient* client, QObject* parent = nullptr);
+
+    // Opens `path` and starts importing; false if the file cannot be read or an import is
+    // already running. Progress is reported through the signals below.
+    bool start(const QString& path, const Options& options = Options());
+    bool isRunning() const { return m_running; }
+    // Why start() returned false or the import stopped early
+    QString errorString() const { return m_fatalError; }
+
+    static QString journalPathFor(const QString& path);
+
+    const Summary& summary() const { return m_summary; }
+    const QList<RowError>& errors() const { return m_errors; }
+
+signals:
+    void progress(int processed, double rowsPerSecond);
+    void rowFailed(int row, const QString& reason);
+    void finished();
+    // The import stopped early; rows sent before that are kept and journaled
+    void failed(const QString& error);
+
+private:
+    static constexpr qint64 ReadChunkSize = 64 * 1024;
+    static constexpr int ProgressIntervalMs = 250;
+
+    enum class Format { Csv, Json };
+
+    struct PendingRow {
+        int row = 0;
+        QString email;
+    };
+
+    void fetchLookups();
+    void lookupReceived();
+    void dropLookupConnections();
+    bool openJournal();
+    void pump();
+    // False once the input is exhausted or unreadable. A row that cannot be split into
+    // fields is returned with `error` set.
+    bool readRow(QJsonObject& row, QString& error);
+    bool readCsvRow(QJsonObject& row, QString& error);
+    bool readJsonRow(QJsonObject& row);
+    QString validate(const QJsonObject& row, QJsonObject& payload) const;
+    void onMutationFinished(int requestId, bool success, const QJsonObject& entity,
+                            const QString& error);
+    void recordFailure(int row, const QString& reason);
+    void reportProgress(bool force);
+    void stop(const QString& error);
+    void finish();
+
+    static QStringList splitCsvLine(const QString& line);
+
+    ApiClient* m_client;
+    QList<QMetaObject::Connection> m_lookupConnections;
+    int m_pendingLookups = 0;
+
+    Options m_options;
+    Format m_format = Format::Csv;
+    QString m_path;
+    QFile m_input;
+    std::unique_ptr<QTextStream> m_csv;
+    QStringList m_columns;
+    JsonArrayReader m_json;
+    bool m_inputDone = false;
+    int m_nextRow = 1;
+
+    QFile m_journal;
+    QSet<int> m_journaledRows;
+
+    // Lower-cased department names and grade codes, plus the ids themselves, to ids
+    QHash<QString, QString> m_departmentIds;
+    QHash<QString, QString> m_gradeIds;
+    // Lower-cased emails already on the server, and those claimed by rows of this run, so
+    // duplicates are caught before they are POSTed
+    QSet<QString> m_existingEmails;
+    QSet<QString> m_claimedEmails;
+
+    QHash<int, PendingRow> m_inFlight;
+    bool m_running = false;
+    QString m_fatalError;
+    QElapsedTimer m_clock;
+    qint64 m_lastProgressMs = -1;
+    Summary m_summary;
+    QList<RowError> m_errors;
+};
+
+#endif // EMPLOYEEIMPORTER_H
@@ -0,0 +1,39 @@
+#ifndef JSONARRAYREADER_H
+#define JSONARRAYREADER_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+// Pull-style reader for a top-level JSON array that arrives in chunks. Feed bytes with
+// addData() and call readNext() until it returns false; each call hands out one complete
+// array element. Only the element currently being received is buffered, so memory stays
+// bounded by the largest element instead of the whole payload.
+class JsonArrayReader {
+public:
+    void addData(const QByteArray& data);
+    bool readNext(QJsonObject& element);
+    // Like readNext(), but hands out the element's bytes unparsed, so parsing can happen
+    // elsewhere, e.g. on another thread. Elements that are not objects or arrays are skipped.
+    bool readNextBytes(QByteArray& element);
+
+    // True once the closing bracket of the array has been read
+    bool atEnd() const { return m_finished; }
+    bool hasError() const { return !m_errorString.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+
+private:
+    void fail(const QString& message);
+
+    QByteArray m_buffer;
+    int m_pos = 0;
+    int m_depth = 0;
+    int m_elementStart = -1;
+    bool m_inString = false;
+    bool m_escaped = false;
+    bool m_started = false;
+    bool m_finished = false;
+    QString m_errorString;
+};
+
+#endif // JSONARRAYREADER_H
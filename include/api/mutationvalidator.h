@@ -0,0 +1,64 @@
+#ifndef MUTATIONVALIDATOR_H
+#define MUTATIONVALIDATOR_H
+
+#include "models/department.h"
+#include "models/employee.h"
+#include "models/salarygrade.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+// Checks employee mutations against the departments, grades and employees ApiClient last
+// delivered, so that ones the server is bound to refuse are turned away before they are
+// sent. Emails and ids sit in hash indices, making a check a few lookups.
+//
+// Only conflicts the local copy proves are reported. A collection that has not been loaded
+// yet is not checked, and whatever passes is still up to the server. The usual employee list
+// leaves out inactive employees, so their emails are only caught by the server, and managers
+// are only checked against a list that included the inactive ones.
+class MutationValidator {
+public:
+    struct Rejection {
+        // API field at fault, e.g. "email" or "department_id"; empty if the mutation is fine
+        QString field;
+        QString reason;
+
+        bool isRejected() const { return !field.isEmpty(); }
+    };
+
+    void setDepartments(const QList<Department>& departments);
+    void setSalaryGrades(const QList<SalaryGrade>& grades);
+    // `includesInactive` tells whether the list was fetched with the inactive employees
+    void setEmployees(const QList<Employee>& employees, bool includesInactive);
+    void addDepartment(const QString& id) { m_departmentIds.insert(id); }
+    void removeDepartment(const QString& id) { m_departmentIds.remove(id); }
+    void addSalaryGrade(const QString& id) { m_gradeIds.insert(id); }
+    void removeSalaryGrade(const QString& id) { m_gradeIds.remove(id); }
+    // Adds `employee` or replaces the earlier version with the same id
+    void upsertEmployee(const Employee& employee);
+    void removeEmployee(const QString& id);
+
+    // `fields` uses the API field names; `id` is empty for a create. Fields that are
+    // missing or null are not checked.
+    Rejection checkEmployee(const QString& id, const QJsonObject& fields) const;
+
+private:
+    static QString emailKey(const QString& email) { return email.trimmed().toLower(); }
+
+    bool m_departmentsLoaded = false;
+    bool m_gradesLoaded = false;
+    bool m_allEmployeesLoaded = false;
+    QSet<QString> m_departmentIds;
+    QSet<QString> m_gradeIds;
+    // Lower-cased email to employee id, and back so an edit can drop the old address
+    QHash<QString, QString> m_idByEmail;
+    QHash<QString, QString> m_emailById;
+    // Every employee id seen since the last list. Deleted ones stay, as they may well live on
+    // as inactive employees that can still be named as managers.
+    QSet<QString> m_knownIds;
+};
+
+#endif // MUTATIONVALIDATOR_H
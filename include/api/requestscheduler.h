@@ -0,0 +1,135 @@
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QTimer>
+
+#include <array>
+
+// One request handed to RequestScheduler. It stays the same object across retries, so
+// callers keep their per-request state on it instead of on a QNetworkReply.
+class ScheduledRequest : public QObject {
+    Q_OBJECT
+
+public:
+    // A RequestScheduler::Priority
+    int priority() const { return m_priority; }
+    // The current attempt; once finished() is emitted, the one that produced the result
+    QNetworkReply* reply() const { return m_reply; }
+    int attempts() const { return m_attempts; }
+
+signals:
+    // Body data of a successful response is available on reply(). Not emitted for
+    // attempts that are going to be retried.
+    void readyRead();
+    void finished();
+
+private:
+    friend class RequestScheduler;
+    explicit ScheduledRequest(QObject* parent) : QObject(parent) {}
+
+    QNetworkRequest m_request;
+    QByteArray m_verb;
+    QByteArray m_body;
+    QNetworkReply* m_reply = nullptr;
+    int m_priority = 0;
+    int m_attempts = 0;
+    // Set once readyRead() went out; the caller saw part of this response, so it is final
+    bool m_delivered = false;
+    QElapsedTimer m_sentAt;
+};
+
+// Dispatches ApiClient's traffic by priority class with an adaptive cap on concurrent
+// requests. Queued requests go out strictly by class, and one slot under the cap is kept
+// for interactive requests so a view waiting for data never sits behind background work
+// that already fills the connections.
+//
+// The cap grows by one request per round trip while latency stays near the best seen,
+// shrinks when it climbs, and is halved on 429 or 503. Those responses also pause dispatch
+// for their Retry-After. Requests the server rejected with 429, and idempotent ones that
+// failed transiently, are retried with jittered exponential backoff.
+class RequestScheduler : public QObject {
+    Q_OBJECT
+
+    Q_PROPERTY(int queueDepth READ queueDepth NOTIFY stateChanged)
+    Q_PROPERTY(int inFlight READ inFlight NOTIFY stateChanged)
+    Q_PROPERTY(int concurrencyLimit READ concurrencyLimit NOTIFY stateChanged)
+    Q_PROPERTY(bool throttled READ throttled NOTIFY stateChanged)
+    Q_PROPERTY(int retries READ retries NOTIFY stateChanged)
+    Q_PROPERTY(int throttledResponses READ throttledResponses NOTIFY stateChanged)
+
+public:
+    // Lower values go first
+    enum Priority {
+        Interactive, // Something on screen is waiting for it
+        Background,  // Keeps data fresh, e.g. the resync after a mutation
+        Bulk         // Large batches such as imports, sent whenever nothing else is waiting
+    };
+    Q_ENUM(Priority)
+    static constexpr int PriorityCount = Bulk + 1;
+
+    // QNetworkAccessManager opens at most six connections per host, so more would only queue
+    static constexpr int MaxConcurrency = 6;
+    static constexpr int MaxAttempts = 4;
+    static constexpr int BackoffBaseMs = 250;
+    static constexpr int BackoffCapMs = 8000;
+    static constexpr int RetryAfterCapMs = 60000;
+
+    explicit RequestScheduler(QNetworkAccessManager* manager, QObject* parent = nullptr);
+
+    // Queues a request for `verb` (GET, POST, PUT or DELETE). The returned object is owned
+    // by the caller once it has emitted finished(); deleting it also deletes its reply.
+    ScheduledRequest* submit(const QNetworkRequest& request, const QByteArray& verb,
+                             Priority priority, const QByteArray& body = QByteArray());
+    // Moves `request` up to `priority` if it is lower; it only jumps the queue if it has
+    // not been sent yet
+    void promote(ScheduledRequest* request, Priority priority);
+
+    // Waiting to be sent, including retries that are backing off
+    int queueDepth() const;
+    int queueDepth(Priority priority) const { return static_cast<int>(m_queues[priority].size()); }
+    int inFlight() const { return m_inFlight; }
+    int concurrencyLimit() const { return static_cast<int>(m_limit); }
+    // Dispatch is paused because the server asked to slow down
+    bool throttled() const { return m_pauseTimer->isActive(); }
+    int retries() const { return m_retries; }
+    int throttledResponses() const { return m_throttledResponses; }
+
+    // Delay a Retry-After header asks for, or -1 without a usable one
+    static int retryAfterMs(const QNetworkReply* reply);
+
+signals:
+    void stateChanged();
+
+private:
+    static constexpr double LatencyTolerance = 2.0;
+    static constexpr double LatencySmoothing = 0.2;
+
+    void dispatch();
+    ScheduledRequest* takeNext();
+    void send(ScheduledRequest* request);
+    void onFinished(ScheduledRequest* request);
+    bool shouldRetry(const ScheduledRequest* request, int status) const;
+    void adaptToLatency(qint64 latencyMs);
+    static int backoffMs(int attempt);
+
+    QNetworkAccessManager* m_manager;
+    std::array<QList<ScheduledRequest*>, PriorityCount> m_queues;
+    QTimer* m_pauseTimer;
+    double m_limit = MaxConcurrency;
+    int m_inFlight = 0;
+    int m_backingOff = 0;
+    int m_retries = 0;
+    int m_throttledResponses = 0;
+    // Best round trip seen, drifting upwards slowly so an old outlier does not pin it
+    double m_baselineMs = -1;
+    double m_smoothedMs = -1;
+};
+
+#endif // REQUESTSCHEDULER_H
@@ -0,0 +1,40 @@
+#ifndef SNAPSHOTCACHE_H
+#define SNAPSHOTCACHE_H
+
+#include "models/department.h"
+#include "models/employee.h"
+#include "models/salarygrade.h"
+
+#include <QList>
+#include <QString>
+
+// Everything the views need to render, as of the last successful sync
+struct Snapshot {
+    QList<Department> departments;
+    QList<Employee> employees;
+    QList<SalaryGrade> salaryGrades;
+};
+
+// Binary copy of the last synced data so startup can render before the server answers.
+// The file is memory-mapped on load and rejected when its format version or checksum
+// does not match.
+class SnapshotCache {
+public:
+    // Bump whenever the serialized layout of an entity changes
+    static constexpr quint32 FormatVersion = 1;
+
+    explicit SnapshotCache(const QString& filePath = defaultPath());
+
+    static QString defaultPath();
+    QString filePath() const { return m_filePath; }
+
+    bool load(Snapshot& snapshot) const;
+    bool save(const Snapshot& snapshot) const;
+    // Drops the file so the next start waits for the server again
+    void invalidate() const;
+
+private:
+    QString m_filePath;
+};
+
+#endif // SNAPSHOTCACHE_H
@@ -2,19 +2,32 @@
 #define PERSONNELAPP_H
 
 #include "api/apiclient.h"
+#include "api/snapshotcache.h"
 #include "gui/material3colors.h"
+#include "models/departmentlistmodel.h"
+#include "models/employeelistmodel.h"
+#include "models/payrollmodel.h"
+#include "models/salarygradelistmodel.h"
+#include "models/salarystatisticsmodel.h"
 
+#include <QFutureWatcher>
 #include <QObject>
 #include <QQmlApplicationEngine>
+#include <QSet>
+#include <QTimer>
+
+#include <optional>
 
 class PersonnelApp : public QObject {
     Q_OBJECT
 
     Q_PROPERTY(int currentTab READ currentTab WRITE setCurrentTab NOTIFY currentTabChanged)
     Q_PROPERTY(bool darkMode READ darkMode WRITE setDarkMode NOTIFY darkModeChanged)
-    Q_PROPERTY(QList<Department> departments READ departments NOTIFY departmentsChanged)
-    Q_PROPERTY(QList<Employee> employees READ employees NOTIFY employeesChanged)
-    Q_PROPERTY(QList<SalaryGrade> salaryGrades READ salaryGrades NOTIFY salaryGradesChanged)
+    Q_PROPERTY(DepartmentListModel* departmentModel READ departmentModel CONSTANT)
+    Q_PROPERTY(EmployeeListModel* employeeModel READ employeeModel CONSTANT)
+    Q_PROPERTY(SalaryGradeListModel* salaryGradeModel READ salaryGradeModel CONSTANT)
+    Q_PROPERTY(PayrollModel* payrollModel READ payrollModel CONSTANT)
+    Q_PROPERTY(SalaryStatisticsModel* salaryStatistics READ salaryStatistics CONSTANT)
     Q_PROPERTY(QString errorMessage READ errorMessage NOTIFY errorMessageChanged)
 
 public:
@@ -26,9 +39,15 @@ public:
     bool darkMode() const { return m_darkMode; }
     void setDarkMode(bool dark);
 
-    QList<Department> departments() const { return m_departments; }
-    QList<Employee> employees() const { return m_employees; }
-    QList<SalaryGrade> salaryGrades() const { return m_salaryGrades; }
+    DepartmentListModel* departmentModel() const { return m_departmentModel; }
+    EmployeeListModel* employeeModel() const { return m_employeeModel; }
+    SalaryGradeListModel* salaryGradeModel() const { return m_salaryGradeModel; }
+    PayrollModel* payrollModel() const { return m_payrollModel; }
+    SalaryStatisticsModel* salaryStatistics() const { return m_salaryStatistics; }
+
+    const QList<Department>& departments() const { return m_departmentModel->items(); }
+    const QList<Employee>& employees() const { return m_employeeModel->items(); }
+    const QList<SalaryGrade>& salaryGrades() const { return m_salaryGradeModel->items(); }
     QString errorMessage() const { return m_errorMessage; }
 
     // Department operations
@@ -57,30 +76,49 @@ public:
                                        const QString& description);
     Q_INVOKABLE void deleteSalaryGrade(const QString& id);
 
+    // Forgets the on-disk snapshot; it is written again after the next sync
+    Q_INVOKABLE void invalidateSnapshot();
+
 signals:
     void currentTabChanged();
     void darkModeChanged();
-    void departmentsChanged();
-    void employeesChanged();
-    void salaryGradesChanged();
     void errorMessageChanged();
 
 private slots:
     void onDepartmentsReceived(QList<Department> departments);
     void onEmployeesReceived(QList<Employee> employees);
     void onSalaryGradesReceived(QList<SalaryGrade> grades);
+    void onEmployeeSaved(Employee employee);
+    void onResyncRequired(ApiClient::Collection collection);
+    void onNotModified(ApiClient::Collection collection);
     void onOperationCompleted(bool success, const QString& message);
     void onErrorOccurred(const QString& error);
+    void saveSnapshot();
+    void startPendingSnapshot();
 
 private:
+    static constexpr int SnapshotDelayMs = 1000;
+
+    void markSynced(ApiClient::Collection collection);
+    void scheduleSnapshot();
+    // Collections the current tab renders, directly or through resolved names
+    QList<ApiClient::Collection> collectionsOnTab(int tab) const;
+
     ApiClient* m_apiClient;
     Material3Colors* m_colors;
     int m_currentTab;
     bool m_darkMode;
-    QList<Department> m_departments;
-    QList<Employee> m_employees;
-    QList<SalaryGrade> m_salaryGrades;
+    DepartmentListModel* m_departmentModel;
+    EmployeeListModel* m_employeeModel;
+    SalaryGradeListModel* m_salaryGradeModel;
+    PayrollModel* m_payrollModel;
+    SalaryStatisticsModel* m_salaryStatistics;
     QString m_errorMessage;
+    SnapshotCache m_snapshotCache;
+    QTimer* m_snapshotTimer;
+    QFutureWatcher<void>* m_snapshotSave;
+    std::optional<Snapshot> m_pendingSnapshot;
+    QSet<ApiClient::Collection> m_syncedCollections;
 };
 
 #endif // PERSONNELAPP_H
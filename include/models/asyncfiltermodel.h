@@ -0,0 +1,88 @@
+#ifndef ASYNCFILTERMODEL_H
+#define ASYNCFILTERMODEL_H
+
+#include <QHash>
+#include <QList>
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+
+// Search-as-you-type proxy that matches on the thread pool. Typing is debounced, and the
+// rows stay as they are until the results for the latest query arrive; they are then
+// applied as row removals and insertions rather than a reset. A query that extends the
+// previous one only re-checks the rows that matched before.
+//
+// Subclasses describe the match as a job that ranks source rows by id.
+class AsyncFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged)
+    Q_PROPERTY(int debounceInterval READ debounceInterval WRITE setDebounceInterval NOTIFY
+                   debounceIntervalChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    // Rank per matching id, lower is better
+    using Ranks = QHash<QString, int>;
+    using MatchJob = std::function<Ranks()>;
+
+    static constexpr int DefaultDebounceMs = 150;
+
+    explicit AsyncFilterModel(QObject* parent = nullptr);
+
+    QString filterText() const { return m_filterText; }
+    void setFilterText(const QString& text);
+
+    int debounceInterval() const { return m_debounceTimer.interval(); }
+    void setDebounceInterval(int msec);
+
+    // True while results for the current filter text are pending
+    bool isBusy() const { return m_busy; }
+
+    int count() const { return rowCount(); }
+
+    void setSourceModel(QAbstractItemModel* model) override;
+
+signals:
+    void filterTextChanged();
+    void debounceIntervalChanged();
+    void busyChanged();
+    void countChanged();
+
+protected:
+    // Returns the work that ranks the rows matching `query` (trimmed, lower case). It runs
+    // on another thread, so it must capture what it reads by value; Qt's implicitly shared
+    // containers make that cheap. `previous` holds the earlier results when `query`
+    // extends their query and the source has not changed since, nullptr otherwise.
+    virtual MatchJob createMatchJob(const QString& query, const Ranks* previous) const = 0;
+    virtual QString idOfRow(int sourceRow) const = 0;
+
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+    bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
+
+    // Schedules a full re-match, for changes to data the match reads besides the source
+    void sourceDataChanged();
+
+private:
+    void startMatch();
+    void applyRanks(const QString& query, const Ranks& ranks, quint64 sourceRevision);
+    bool visibleOrderHolds(const QString& query, const Ranks& ranks) const;
+    void setBusy(bool busy);
+
+    QString m_filterText;
+    QTimer m_debounceTimer;
+    bool m_busy = false;
+
+    // Query and results currently reflected by the rows
+    QString m_appliedQuery;
+    Ranks m_ranks;
+    bool m_ranksCurrent = true;
+
+    quint64 m_matchGeneration = 0;
+    quint64 m_sourceRevision = 0;
+    QList<QMetaObject::Connection> m_sourceConnections;
+};
+
+#endif // ASYNCFILTERMODEL_H
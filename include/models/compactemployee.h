@@ -0,0 +1,102 @@
+#ifndef COMPACTEMPLOYEE_H
+#define COMPACTEMPLOYEE_H
+
+#include "models/compactid.h"
+#include "models/employee.h"
+
+#include <QDateTime>
+#include <QString>
+#include <QStringView>
+
+#include <array>
+#include <limits>
+
+// Conversion of an Employee into a denser form: the four ids are CompactIds, the role is an
+// index into StringTable::roles(), the timestamps are UTC milliseconds since the epoch, and
+// first name, last name and email share one string. Ids, roles and timestamps compare as
+// integers. The employee list and the indices built on it keep their own fields; this type
+// is not what they store.
+//
+// fromEmployee() and toEmployee() round-trip every field; timestamps keep their UTC offset
+// or local time spec (a Qt::TimeZone spec comes back as its offset). The properties mirror
+// Employee's, so QML can read either.
+class CompactEmployee {
+    Q_GADGET
+    Q_PROPERTY(QString id READ idString)
+    Q_PROPERTY(QString firstName READ firstNameString)
+    Q_PROPERTY(QString lastName READ lastNameString)
+    Q_PROPERTY(QString email READ emailString)
+    Q_PROPERTY(QString role READ roleString)
+    Q_PROPERTY(bool active READ isActive)
+    Q_PROPERTY(QString departmentId READ departmentIdString)
+    Q_PROPERTY(QString managerId READ managerIdString)
+    Q_PROPERTY(QString salaryGradeId READ salaryGradeIdString)
+    Q_PROPERTY(QDateTime hireDate READ hireDate)
+    Q_PROPERTY(QDateTime createdAt READ createdAt)
+    Q_PROPERTY(QDateTime updatedAt READ updatedAt)
+    Q_PROPERTY(QDateTime deletedAt READ deletedAt)
+
+public:
+    enum Timestamp { HireDate, CreatedAt, UpdatedAt, DeletedAt, TimestampCount };
+
+    // Epoch value of a timestamp that is not set
+    static constexpr qint64 NoTime = std::numeric_limits<qint64>::min();
+
+    CompactEmployee() = default;
+
+    static CompactEmployee fromEmployee(const Employee& employee);
+    Employee toEmployee() const;
+
+    CompactId id;
+    CompactId departmentId;
+    CompactId managerId;
+    CompactId salaryGradeId;
+    quint32 role = 0;
+    bool active = true;
+
+    QStringView firstName() const { return QStringView(m_text).left(m_firstNameLength); }
+    QStringView lastName() const {
+        return QStringView(m_text).mid(m_firstNameLength, m_lastNameLength);
+    }
+    QStringView email() const {
+        return QStringView(m_text).mid(m_firstNameLength + m_lastNameLength);
+    }
+    void setText(const QString& firstName, const QString& lastName, const QString& email);
+
+    // UTC milliseconds since the epoch, or NoTime
+    qint64 epochMs(Timestamp which) const { return m_epochMs[which]; }
+    QDateTime dateTime(Timestamp which) const;
+    void setDateTime(Timestamp which, const QDateTime& dateTime);
+
+    QString idString() const { return id.toString(); }
+    QString firstNameString() const { return firstName().toString(); }
+    QString lastNameString() const { return lastName().toString(); }
+    QString emailString() const { return email().toString(); }
+    QString roleString() const;
+    bool isActive() const { return active; }
+    QString departmentIdString() const { return departmentId.toString(); }
+    QString managerIdString() const { return managerId.toString(); }
+    QString salaryGradeIdString() const { return salaryGradeId.toString(); }
+    QDateTime hireDate() const { return dateTime(HireDate); }
+    QDateTime createdAt() const { return dateTime(CreatedAt); }
+    QDateTime updatedAt() const { return dateTime(UpdatedAt); }
+    QDateTime deletedAt() const { return dateTime(DeletedAt); }
+
+    // Equal exactly when the Employees they came from are
+    bool operator==(const CompactEmployee& other) const;
+    bool operator!=(const CompactEmployee& other) const { return !(*this == other); }
+
+private:
+    // Offset of a local time, which has to be looked up again when converting back
+    static constexpr qint32 LocalTime = std::numeric_limits<qint32>::min();
+
+    QString m_text;
+    int m_firstNameLength = 0;
+    int m_lastNameLength = 0;
+    std::array<qint64, TimestampCount> m_epochMs = {NoTime, NoTime, NoTime, NoTime};
+    std::array<qint32, TimestampCount> m_offsets = {};
+};
+
+Q_DECLARE_METATYPE(CompactEmployee)
+
+#endif // COMPACTEMPLOYEE_H
@@ -0,0 +1,50 @@
+#ifndef COMPACTID_H
+#define COMPACTID_H
+
+#include <QHashFunctions>
+#include <QString>
+#include <QStringView>
+#include <QtGlobal>
+
+// An entity id in 16 bytes without heap storage. The server issues lower-case RFC 4122
+// UUIDs, which are kept as their 128 bits. Any other text is interned in
+// StringTable::ids() instead, so toString() always gives back exactly what was parsed.
+class CompactId {
+public:
+    CompactId() = default;
+
+    static CompactId fromString(const QString& text);
+    // For lookups: like fromString(), but text that was never parsed is not interned and
+    // gives a null id
+    static CompactId find(const QString& text);
+    QString toString() const;
+
+    // Parsed from an empty string
+    bool isNull() const { return m_high == 0 && m_low == 0; }
+    bool isUuid() const { return (m_low >> 62) == 0x2; }
+
+    bool operator==(const CompactId& other) const {
+        return m_high == other.m_high && m_low == other.m_low;
+    }
+    bool operator!=(const CompactId& other) const { return !(*this == other); }
+    // An arbitrary but stable order, for sorting and binary search
+    bool operator<(const CompactId& other) const {
+        return m_high != other.m_high ? m_high < other.m_high : m_low < other.m_low;
+    }
+
+    friend size_t qHash(const CompactId& id, size_t seed = 0) noexcept {
+        return qHashMulti(seed, id.m_high, id.m_low);
+    }
+
+private:
+    // Interned ids use m_low = index + 1 with m_high = 0. A UUID's variant bits keep the
+    // top of m_low at 0b10, so the two never collide.
+    static bool parseUuid(QStringView text, quint64& high, quint64& low);
+
+    quint64 m_high = 0;
+    quint64 m_low = 0;
+};
+
+Q_DECLARE_TYPEINFO(CompactId, Q_PRIMITIVE_TYPE);
+
+#endif // COMPACTID_H
@@ -27,6 +27,12 @@ public:
 
     static Department fromJson(const QJsonObject& json);
     QJsonObject toJson() const;
+    // Body that puts the stored department back as it is now; unlike toJson() it names the
+    // missing head as null, so a head added since is cleared again
+    QJsonObject toRestoreJson() const;
+
+    bool operator==(const Department& other) const;
+    bool operator!=(const Department& other) const { return !(*this == other); }
 };
 
 Q_DECLARE_METATYPE(Department)
@@ -0,0 +1,34 @@
+#ifndef DEPARTMENTFILTERMODEL_H
+#define DEPARTMENTFILTERMODEL_H
+
+#include "models/asyncfiltermodel.h"
+#include "models/departmentlistmodel.h"
+#include "models/employeelistmodel.h"
+
+#include <QPointer>
+
+// Case-insensitive search over a DepartmentListModel by department name, and by the
+// head's name when an employee model is attached. Name matches rank before head matches.
+class DepartmentFilterModel : public AsyncFilterModel {
+    Q_OBJECT
+    Q_PROPERTY(EmployeeListModel* employeeModel READ employeeModel WRITE setEmployeeModel NOTIFY
+                   employeeModelChanged)
+
+public:
+    explicit DepartmentFilterModel(QObject* parent = nullptr);
+
+    EmployeeListModel* employeeModel() const { return m_employeeModel; }
+    void setEmployeeModel(EmployeeListModel* model);
+
+signals:
+    void employeeModelChanged();
+
+protected:
+    MatchJob createMatchJob(const QString& query, const Ranks* previous) const override;
+    QString idOfRow(int sourceRow) const override;
+
+private:
+    QPointer<EmployeeListModel> m_employeeModel;
+};
+
+#endif // DEPARTMENTFILTERMODEL_H
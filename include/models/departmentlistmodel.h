@@ -0,0 +1,60 @@
+#ifndef DEPARTMENTLISTMODEL_H
+#define DEPARTMENTLISTMODEL_H
+
+#include "models/department.h"
+#include "models/keyedlistmodel.h"
+
+#include <QMultiHash>
+#include <QPointer>
+#include <QStringList>
+
+class EmployeeListModel;
+
+class DepartmentListModel : public KeyedListModel<Department> {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        NameRole,
+        HeadIdRole,
+        // Resolved through the employee model, if set
+        HeadNameRole
+    };
+
+    explicit DepartmentListModel(QObject* parent = nullptr);
+
+    int count() const { return rowCount(); }
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE int indexOfId(const QString& id) const { return rowOfId(id); }
+    Q_INVOKABLE QString nameOf(const QString& id) const;
+    Q_INVOKABLE QStringList idsHeadedBy(const QString& employeeId) const;
+
+    void setEmployeeModel(EmployeeListModel* model);
+
+signals:
+    void countChanged();
+
+protected:
+    QVariant dataForRole(const Department& department, int role) const override;
+    void itemAdded(const Department& department) override;
+    void itemRemoved(const Department& department) override;
+
+private:
+    void onEmployeesChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight,
+                            const QList<int>& roles);
+    void onEmployeesInserted(const QModelIndex& parent, int first, int last);
+    void onEmployeesAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    void onEmployeesRemoved();
+    void notifyHeadedBy(const QString& employeeId);
+    void notifyAllRows(int role);
+
+    QPointer<EmployeeListModel> m_employeeModel;
+    QMultiHash<QString, QString> m_idsByHead;
+    // Employees on their way out, whose departments are notified once they are gone
+    QStringList m_removedEmployeeIds;
+};
+
+#endif // DEPARTMENTLISTMODEL_H
@@ -42,6 +42,9 @@ public:
 
     static Employee fromJson(const QJsonObject& json);
     QJsonObject toJson() const;
+
+    bool operator==(const Employee& other) const;
+    bool operator!=(const Employee& other) const { return !(*this == other); }
 };
 
 Q_DECLARE_METATYPE(Employee)
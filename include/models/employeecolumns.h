@@ -0,0 +1,74 @@
+#ifndef EMPLOYEECOLUMNS_H
+#define EMPLOYEECOLUMNS_H
+
+#include "models/compactid.h"
+#include "models/employee.h"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+// Column-oriented copy of the fields aggregate queries scan: department, salary grade,
+// active flag and hire date, each in its own contiguous array with one entry per employee.
+// Departments and grades are dictionary-encoded as small indices, so a scan touches a few
+// bytes per employee instead of chasing the strings and dates inside Employee.
+//
+// Removing an employee moves the last row into its place, so the arrays stay dense and
+// every edit is O(1). Row order is therefore arbitrary; rows only line up across columns.
+class EmployeeColumns {
+public:
+    // Index of an employee without a department or grade
+    static constexpr qint32 None = -1;
+
+    // Adds `employee`, replacing an earlier entry with the same id
+    void insert(const Employee& employee);
+    void remove(const QString& id);
+    void clear();
+
+    int size() const { return static_cast<int>(m_ids.size()); }
+    bool contains(const QString& id) const {
+        return m_rowById.contains(CompactId::find(id));
+    }
+
+    const QList<qint32>& departmentColumn() const { return m_department; }
+    const QList<qint32>& gradeColumn() const { return m_grade; }
+    // 1 for active employees, 0 otherwise
+    const QList<quint8>& activeColumn() const { return m_active; }
+    // UTC milliseconds since the epoch, CompactEmployee::NoTime when unknown
+    const QList<qint64>& hireDateColumn() const { return m_hireDate; }
+
+    // Every department and grade id seen so far; the column values index these. Entries
+    // stay after their last employee is gone, so indices never change meaning.
+    const QList<CompactId>& departmentIds() const { return m_departmentIds; }
+    const QList<CompactId>& gradeIds() const { return m_gradeIds; }
+    qint32 departmentIndexOf(const QString& departmentId) const;
+    qint32 gradeIndexOf(const QString& gradeId) const;
+
+    // Employees per entry of departmentIds() / gradeIds()
+    QList<int> countByDepartment(bool activeOnly = false) const;
+    QList<int> countByGrade(bool activeOnly = false) const;
+    // Sum over each department's employees of `valueByGrade[grade]`, e.g. base salaries.
+    // Employees without a grade, or with one past the end of `valueByGrade`, add nothing.
+    QList<double> sumByDepartment(const QList<double>& valueByGrade,
+                                  bool activeOnly = false) const;
+    // Employees hired in [fromMs, toMs)
+    int countHiredBetween(qint64 fromMs, qint64 toMs, bool activeOnly = false) const;
+
+private:
+    static qint32 intern(const QString& id, QHash<CompactId, qint32>& indices,
+                         QList<CompactId>& ids);
+
+    QList<CompactId> m_ids;
+    QList<qint32> m_department;
+    QList<qint32> m_grade;
+    QList<quint8> m_active;
+    QList<qint64> m_hireDate;
+    QHash<CompactId, int> m_rowById;
+
+    QList<CompactId> m_departmentIds;
+    QList<CompactId> m_gradeIds;
+    QHash<CompactId, qint32> m_departmentIndex;
+    QHash<CompactId, qint32> m_gradeIndex;
+};
+
+#endif // EMPLOYEECOLUMNS_H
@@ -0,0 +1,94 @@
+#ifndef EMPLOYEECOMPLETIONMODEL_H
+#define EMPLOYEECOMPLETIONMODEL_H
+
+#include "models/employeelistmodel.h"
+#include "models/keyedlistmodel.h"
+
+#include <QPointer>
+#include <QTimer>
+
+struct EmployeeCompletion {
+    QString id;
+    QString fullName;
+    QString role;
+
+    bool operator==(const EmployeeCompletion& other) const {
+        return id == other.id && fullName == other.fullName && role == other.role;
+    }
+};
+
+// The best few matches for a query, answered from the shared search index of an
+// EmployeeListModel. Pickers use this instead of filtering the whole roster each, and
+// only hold `limit` rows. While inactive the model is empty and ignores the source.
+class EmployeeCompletionModel : public KeyedListModel<EmployeeCompletion> {
+    Q_OBJECT
+    Q_PROPERTY(EmployeeListModel* employeeModel READ employeeModel WRITE setEmployeeModel NOTIFY
+                   employeeModelChanged)
+    Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+    Q_PROPERTY(QString roleFilter READ roleFilter WRITE setRoleFilter NOTIFY roleFilterChanged)
+    Q_PROPERTY(QString departmentFilter READ departmentFilter WRITE setDepartmentFilter NOTIFY
+                   departmentFilterChanged)
+    Q_PROPERTY(int limit READ limit WRITE setLimit NOTIFY limitChanged)
+    Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    // More matches exist than are shown
+    Q_PROPERTY(bool truncated READ isTruncated NOTIFY truncatedChanged)
+
+public:
+    enum Roles { IdRole = Qt::UserRole + 1, FullNameRole, RoleRole };
+
+    static constexpr int DefaultLimit = 50;
+
+    explicit EmployeeCompletionModel(QObject* parent = nullptr);
+
+    QHash<int, QByteArray> roleNames() const override;
+
+    EmployeeListModel* employeeModel() const { return m_employeeModel; }
+    void setEmployeeModel(EmployeeListModel* model);
+
+    QString query() const { return m_query; }
+    void setQuery(const QString& query);
+
+    QString roleFilter() const { return m_roleFilter; }
+    void setRoleFilter(const QString& role);
+
+    QString departmentFilter() const { return m_departmentFilter; }
+    void setDepartmentFilter(const QString& departmentId);
+
+    int limit() const { return m_limit; }
+    void setLimit(int limit);
+
+    bool isActive() const { return m_active; }
+    void setActive(bool active);
+
+    int count() const { return rowCount(); }
+    bool isTruncated() const { return m_truncated; }
+
+signals:
+    void employeeModelChanged();
+    void queryChanged();
+    void roleFilterChanged();
+    void departmentFilterChanged();
+    void limitChanged();
+    void activeChanged();
+    void countChanged();
+    void truncatedChanged();
+
+protected:
+    QVariant dataForRole(const EmployeeCompletion& item, int role) const override;
+
+private:
+    void update();
+
+    QPointer<EmployeeListModel> m_employeeModel;
+    QString m_query;
+    QString m_roleFilter;
+    QString m_departmentFilter;
+    int m_limit = DefaultLimit;
+    bool m_active = true;
+    bool m_truncated = false;
+    // Coalesces bursts of source changes, e.g. while a list streams in
+    QTimer m_sourceChangedTimer;
+};
+
+#endif // EMPLOYEECOMPLETIONMODEL_H
@@ -0,0 +1,21 @@
+#ifndef EMPLOYEEFILTERMODEL_H
+#define EMPLOYEEFILTERMODEL_H
+
+#include "models/asyncfiltermodel.h"
+#include "models/employeelistmodel.h"
+
+// Case-insensitive search over an EmployeeListModel. Matches name, email, role and
+// department name through the source's search index and orders rows by match quality;
+// with an empty query all rows are shown in source order.
+class EmployeeFilterModel : public AsyncFilterModel {
+    Q_OBJECT
+
+public:
+    explicit EmployeeFilterModel(QObject* parent = nullptr);
+
+protected:
+    MatchJob createMatchJob(const QString& query, const Ranks* previous) const override;
+    QString idOfRow(int sourceRow) const override;
+};
+
+#endif // EMPLOYEEFILTERMODEL_H
@@ -0,0 +1,102 @@
+#ifndef EMPLOYEELISTMODEL_H
+#define EMPLOYEELISTMODEL_H
+
+#include "models/employee.h"
+#include "models/employeecolumns.h"
+#include "models/employeesearchindex.h"
+#include "models/keyedlistmodel.h"
+#include "models/managerhierarchy.h"
+
+#include <QMultiHash>
+#include <QPointer>
+#include <QStringList>
+
+class DepartmentListModel;
+class SalaryGradeListModel;
+
+class EmployeeListModel : public KeyedListModel<Employee> {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        FirstNameRole,
+        LastNameRole,
+        FullNameRole,
+        EmailRole,
+        RoleRole,
+        ActiveRole,
+        DepartmentIdRole,
+        ManagerIdRole,
+        SalaryGradeIdRole,
+        HireDateRole,
+        // Resolved through the department and salary grade models, if set
+        DepartmentNameRole,
+        SalaryGradeLabelRole
+    };
+
+    explicit EmployeeListModel(QObject* parent = nullptr);
+
+    int count() const { return rowCount(); }
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE int indexOfId(const QString& id) const { return rowOfId(id); }
+    Q_INVOKABLE QString fullNameOf(const QString& id) const;
+    // Case-insensitive; empty if nobody uses the address
+    Q_INVOKABLE QString idOfEmail(const QString& email) const;
+    Q_INVOKABLE QStringList reportIdsOf(const QString& managerId) const;
+    // Direct and indirect reports
+    Q_INVOKABLE QStringList allReportIdsOf(const QString& managerId) const;
+    // Managers of `id`, from the direct one upwards
+    Q_INVOKABLE QStringList chainOfCommandOf(const QString& id) const;
+    // True if `id` reporting to `managerId` would close a loop in the reporting chain
+    Q_INVOKABLE bool wouldCreateCycle(const QString& id, const QString& managerId) const;
+    Q_INVOKABLE QStringList memberIdsOf(const QString& departmentId) const;
+    // Ids matching `text` in name, email, role or department, best first; -1 for no limit
+    Q_INVOKABLE QStringList search(const QString& text, int limit = -1) const;
+    // The `limit` best completions for `text`, prefix matches first and then by name.
+    // Empty `role` / `departmentId` leave that constraint out.
+    Q_INVOKABLE QStringList complete(const QString& text, int limit,
+                                     const QString& role = QString(),
+                                     const QString& departmentId = QString()) const;
+
+    const EmployeeSearchIndex& searchIndex() const { return m_searchIndex; }
+    // Department, grade, active flag and hire date of every row, for aggregate scans
+    const EmployeeColumns& columns() const { return m_columns; }
+    const ManagerHierarchy& hierarchy() const { return m_hierarchy; }
+
+    // Sources for the resolved roles; their changes are forwarded as dataChanged
+    void setDepartmentModel(DepartmentListModel* model);
+    void setSalaryGradeModel(SalaryGradeListModel* model);
+
+signals:
+    void countChanged();
+    // Every row entering or leaving the model, an edit being the removal of the old value
+    // followed by the new one. Emitted in the middle of the model's own update, so
+    // receivers must not read the model back.
+    void employeeAdded(const Employee& employee);
+    void employeeRemoved(const Employee& employee);
+
+protected:
+    QVariant dataForRole(const Employee& employee, int role) const override;
+    void itemAdded(const Employee& employee) override;
+    void itemRemoved(const Employee& employee) override;
+
+private:
+    void onDepartmentsChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight,
+                              const QList<int>& roles);
+    void notifyAllRows(int role);
+    void onDepartmentsReset();
+    QString departmentNameOf(const Employee& employee) const;
+
+    QPointer<DepartmentListModel> m_departmentModel;
+    QPointer<SalaryGradeListModel> m_salaryGradeModel;
+    QHash<QString, QString> m_idByEmail;
+    QMultiHash<QString, QString> m_memberIds;
+    EmployeeSearchIndex m_searchIndex;
+    EmployeeColumns m_columns;
+    ManagerHierarchy m_hierarchy;
+};
+
+#endif // EMPLOYEELISTMODEL_H
@@ -0,0 +1,67 @@
+#ifndef EMPLOYEESEARCHINDEX_H
+#define EMPLOYEESEARCHINDEX_H
+
+#include "models/employee.h"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+// Trigram inverted index over employee name, email, role and department name. Substring
+// queries intersect the posting lists of the query's trigrams and only verify the few
+// candidates left, instead of scanning every employee.
+//
+// Entries live in slots that are only ever appended, so posting lists stay sorted without
+// extra work. Removing an entry leaves a tombstone that is compacted away once tombstones
+// outnumber live entries.
+class EmployeeSearchIndex {
+public:
+    struct Hit {
+        QString id;
+        int rank; // Lower is better
+    };
+
+    // Adds or refreshes the entry for `employee`; unchanged entries are left alone
+    void insert(const Employee& employee, const QString& departmentName);
+    void remove(const QString& id);
+    void clear();
+
+    int size() const { return static_cast<int>(m_slotById.size()); }
+    bool contains(const QString& id) const { return m_slotById.contains(id); }
+    QString departmentNameOf(const QString& id) const;
+
+    // Entries with a field containing `text` (case-insensitive), best matches first
+    QList<Hit> search(const QString& text) const;
+    // Same, but only considers `candidates`; for a query that extends the one they matched
+    QList<Hit> search(const QString& text, const QStringList& candidates) const;
+    // The `limit` best entries passing `accept`, ties broken by name (-1 for no limit).
+    // An empty text matches every entry.
+    QList<Hit> topMatches(const QString& text, int limit,
+                          const std::function<bool(const QString& id)>& accept = {}) const;
+
+private:
+    struct Entry {
+        QString id;
+        QString name;
+        QString email;
+        QString role;
+        QString department;
+        bool alive = true;
+    };
+
+    static int rankOf(const Entry& entry, const QString& query);
+    QList<int> candidateSlots(const QString& query) const;
+    void collect(int slot, const QString& query, QList<Hit>& hits) const;
+    void addTrigrams(int slot, const QString& field);
+    void compact();
+
+    QList<Entry> m_entries;
+    QHash<QString, int> m_slotById;
+    QHash<quint64, QList<int>> m_postings;
+    int m_deadCount = 0;
+};
+
+#endif // EMPLOYEESEARCHINDEX_H
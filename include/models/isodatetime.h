@@ -0,0 +1,22 @@
+#ifndef ISODATETIME_H
+#define ISODATETIME_H
+
+#include <QDateTime>
+#include <QJsonValue>
+#include <QString>
+#include <QStringView>
+
+// Parses the timestamps the API sends, "YYYY-MM-DD" and RFC 3339 date-times such as
+// "2024-01-15T10:30:00.123456Z", straight from the characters; the parsing itself does not
+// allocate. Anything else goes through QDateTime::fromString(Qt::ISODate), and either way
+// the result is the same as that would give, time spec included.
+QDateTime parseIsoDateTime(QStringView text);
+// QString converts to both QStringView and QJsonValue, so it needs its own overload
+inline QDateTime parseIsoDateTime(const QString& text) {
+    return parseIsoDateTime(QStringView(text));
+}
+// For optional fields: a missing, null or non-string value gives an invalid QDateTime.
+// QJsonValue only hands out its string as a QString, so this costs one string copy per call.
+QDateTime parseIsoDateTime(const QJsonValue& value);
+
+#endif // ISODATETIME_H
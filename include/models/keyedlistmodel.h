@@ -0,0 +1,269 @@
+#ifndef KEYEDLISTMODEL_H
+#define KEYEDLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include <algorithm>
+
+// Common storage for the entity list models. Rows are addressed by position for the
+// views and by entity id for lookups, so both directions stay O(1).
+template <typename T>
+class KeyedListModel : public QAbstractListModel {
+public:
+    explicit KeyedListModel(QObject* parent = nullptr) : QAbstractListModel(parent) {}
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : static_cast<int>(m_items.size());
+    }
+
+    QVariant data(const QModelIndex& index, int role) const override {
+        if (!index.isValid() || index.row() < 0 || index.row() >= m_items.size())
+            return QVariant();
+        return dataForRole(m_items.at(index.row()), role);
+    }
+
+    const QList<T>& items() const { return m_items; }
+
+    int rowOfId(const QString& id) const {
+        ensureIndex();
+        return m_rowById.value(id, -1);
+    }
+    bool containsId(const QString& id) const { return rowOfId(id) >= 0; }
+
+    const T* itemById(const QString& id) const {
+        int row = rowOfId(id);
+        return row >= 0 ? &m_items.at(row) : nullptr;
+    }
+
+    // Brings the model in line with `items`, matching rows by id. Instead of a reset this
+    // emits row removals, insertions and moves plus dataChanged for rows whose content
+    // differs, so views only rebuild the delegates that were actually touched.
+    void setItems(const QList<T>& items) {
+        QHash<QString, int> targetRow;
+        targetRow.reserve(items.size());
+        for (int row = 0; row < items.size(); ++row)
+            targetRow.insert(items.at(row).id, row);
+
+        // Nothing to preserve, or ids are not unique enough to diff on
+        ensureIndex();
+        if (m_items.isEmpty() || items.isEmpty() || targetRow.size() != items.size() ||
+            m_rowById.size() != m_items.size()) {
+            beginResetModel();
+            for (const T& item : m_items)
+                itemRemoved(item);
+            m_items = items;
+            for (const T& item : m_items)
+                itemAdded(item);
+            rebuildIndex();
+            endResetModel();
+            return;
+        }
+
+        removeRowsMissingFrom(targetRow);
+        placeRows(items, targetRow);
+    }
+
+    // Replaces the row with the same id, or appends `item` if the id is new
+    void upsert(const T& item) {
+        int row = rowOfId(item.id);
+        if (row >= 0) {
+            if (m_items.at(row) == item)
+                return;
+            replaceRow(row, item);
+            QModelIndex changed = index(row);
+            emit dataChanged(changed, changed);
+            return;
+        }
+        row = static_cast<int>(m_items.size());
+        beginInsertRows(QModelIndex(), row, row);
+        m_items.append(item);
+        m_rowById.insert(item.id, row);
+        itemAdded(item);
+        endInsertRows();
+    }
+
+    // Batch form of upsert(); ids not seen before are appended in one insertion
+    void upsertAll(const QList<T>& items) {
+        QList<T> appended;
+        for (const T& item : items) {
+            int row = rowOfId(item.id);
+            if (row < 0) {
+                appended.append(item);
+            } else if (!(m_items.at(row) == item)) {
+                replaceRow(row, item);
+                QModelIndex changed = index(row);
+                emit dataChanged(changed, changed);
+            }
+        }
+        if (appended.isEmpty())
+            return;
+
+        int first = static_cast<int>(m_items.size());
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(appended.size()) - 1);
+        for (const T& item : appended) {
+            m_rowById.insert(item.id, static_cast<int>(m_items.size()));
+            m_items.append(item);
+            itemAdded(item);
+        }
+        endInsertRows();
+    }
+
+    bool removeId(const QString& id) {
+        int row = rowOfId(id);
+        if (row < 0)
+            return false;
+        beginRemoveRows(QModelIndex(), row, row);
+        itemRemoved(m_items.at(row));
+        m_items.removeAt(row);
+        m_rowById.remove(id);
+        for (int i = row; i < m_items.size(); ++i)
+            m_rowById[m_items.at(i).id] = i;
+        endRemoveRows();
+        return true;
+    }
+
+protected:
+    virtual QVariant dataForRole(const T& item, int role) const = 0;
+
+    // Hooks for secondary indices; called whenever an item enters or leaves the model,
+    // with an edit reported as removal of the old value followed by the new one
+    virtual void itemAdded(const T& item) { Q_UNUSED(item); }
+    virtual void itemRemoved(const T& item) { Q_UNUSED(item); }
+
+private:
+    void replaceRow(int row, const T& item) {
+        itemRemoved(m_items.at(row));
+        m_items[row] = item;
+        itemAdded(item);
+    }
+
+    // Structural steps of a diff only mark the index dirty; lookups made from their
+    // signals then rebuild it, so it is never stale while someone can observe it
+    void ensureIndex() const {
+        if (m_indexDirty)
+            rebuildIndex();
+    }
+
+    void rebuildIndex() const {
+        m_rowById.clear();
+        m_rowById.reserve(m_items.size());
+        for (int row = 0; row < m_items.size(); ++row)
+            m_rowById.insert(m_items.at(row).id, row);
+        m_indexDirty = false;
+    }
+
+    // Drops rows whose id is gone, back to front so contiguous runs go in one notification
+    void removeRowsMissingFrom(const QHash<QString, int>& targetRow) {
+        for (int last = static_cast<int>(m_items.size()) - 1; last >= 0;) {
+            if (targetRow.contains(m_items.at(last).id)) {
+                --last;
+                continue;
+            }
+            int first = last;
+            while (first > 0 && !targetRow.contains(m_items.at(first - 1).id))
+                --first;
+            beginRemoveRows(QModelIndex(), first, last);
+            for (int row = first; row <= last; ++row)
+                itemRemoved(m_items.at(row));
+            m_items.remove(first, last - first + 1);
+            m_indexDirty = true;
+            endRemoveRows();
+            last = first - 1;
+        }
+    }
+
+    // Moves surviving rows into target order, then inserts new rows and refreshes changed
+    // ones. Rows on the longest increasing run of target positions stay where they are and
+    // every other row moves at most once, so a single reordered entry costs a single move.
+    void placeRows(const QList<T>& items, const QHash<QString, int>& targetRow) {
+        const int targetCount = static_cast<int>(items.size());
+        QList<bool> present(targetCount, false);
+        QList<bool> stable(targetCount, false);
+        QList<int> currentTargets;
+        currentTargets.reserve(m_items.size());
+        for (const T& item : m_items) {
+            int target = targetRow.value(item.id);
+            present[target] = true;
+            currentTargets.append(target);
+        }
+        for (int target : longestIncreasingRun(currentTargets))
+            stable[target] = true;
+
+        // In ascending target order, so everything that belongs in front of a row has
+        // already been placed when it moves and it can go straight behind its predecessor.
+        // The index follows each move, only over the rows that shifted, so finding a row
+        // stays O(1) however much the order changed.
+        ensureIndex();
+        int previous = -1;
+        for (int target = 0; target < targetCount; ++target) {
+            if (!present[target])
+                continue;
+            if (!stable[target]) {
+                int from = m_rowById.value(items.at(target).id);
+                int dest = previous < 0 ? 0 : m_rowById.value(items.at(previous).id) + 1;
+                if (dest != from && dest != from + 1) {
+                    int to = from < dest ? dest - 1 : dest;
+                    beginMoveRows(QModelIndex(), from, from, QModelIndex(), dest);
+                    m_items.move(from, to);
+                    for (int row = std::min(from, to); row <= std::max(from, to); ++row)
+                        m_rowById[m_items.at(row).id] = row;
+                    endMoveRows();
+                }
+            }
+            previous = target;
+        }
+
+        for (int row = 0; row < targetCount; ++row) {
+            if (!present[row]) {
+                int last = row;
+                while (last + 1 < targetCount && !present[last + 1])
+                    ++last;
+                beginInsertRows(QModelIndex(), row, last);
+                for (int i = row; i <= last; ++i) {
+                    m_items.insert(i, items.at(i));
+                    itemAdded(items.at(i));
+                }
+                m_indexDirty = true;
+                endInsertRows();
+                row = last;
+            } else if (!(m_items.at(row) == items.at(row))) {
+                replaceRow(row, items.at(row));
+                QModelIndex changed = index(row);
+                emit dataChanged(changed, changed);
+            }
+        }
+    }
+
+    // Values of the longest strictly increasing subsequence (patience sorting)
+    static QList<int> longestIncreasingRun(const QList<int>& values) {
+        QList<int> tails;
+        QList<int> previous(values.size(), -1);
+        for (int i = 0; i < values.size(); ++i) {
+            auto pos = std::lower_bound(tails.begin(), tails.end(), values.at(i),
+                                        [&values](int tail, int value) {
+                                            return values.at(tail) < value;
+                                        });
+            int slot = static_cast<int>(pos - tails.begin());
+            if (slot > 0)
+                previous[i] = tails.at(slot - 1);
+            if (slot == tails.size())
+                tails.append(i);
+            else
+                tails[slot] = i;
+        }
+
+        QList<int> run;
+        for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = previous.at(i))
+            run.append(values.at(i));
+        return run;
+    }
+
+    QList<T> m_items;
+    mutable QHash<QString, int> m_rowById;
+    mutable bool m_indexDirty = false;
+};
+
+#endif // KEYEDLISTMODEL_H
@@ -0,0 +1,91 @@
+#ifndef MANAGERHIERARCHY_H
+#define MANAGERHIERARCHY_H
+
+#include "models/compactid.h"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// The reporting tree formed by Employee::managerId. Every node keeps a parent index and its
+// direct reports, which are edited in O(1) when a manager changes. Queries walk those links:
+// the reports under a manager in O(reports), "is A above B" in O(depth of B).
+//
+// While the tree goes unedited, each node can also carry an interval label from a
+// depth-first walk of the whole forest: its position in the walk and the size of its
+// subtree. With those, "is A above B" is two comparisons, counting reports is O(1) and
+// listing them is one contiguous slice. Any edit drops the labels. They are rebuilt, in
+// O(n), only once queries since the last edit have walked n nodes between them, so
+// relabeling at most doubles the cost of the walks it replaces and edits interleaved with
+// queries never pay for it.
+//
+// A manager id that is not (yet) an employee gets a placeholder node, so reports that
+// arrive before their manager link up once it does. Reporting cycles in the data are
+// broken arbitrarily for labeling.
+class ManagerHierarchy {
+public:
+    // Adds `employeeId`, or moves it, under `managerId`; an empty manager makes it a root
+    void setManager(const QString& employeeId, const QString& managerId);
+    // Its reports stay attached and move along if it comes back
+    void remove(const QString& employeeId);
+    void clear();
+
+    bool contains(const QString& employeeId) const;
+    QString managerOf(const QString& employeeId) const;
+
+    // Direct reports, in no particular order
+    QStringList directReportsOf(const QString& managerId) const;
+    // Number of direct reports
+    int spanOfControl(const QString& managerId) const;
+    // Everyone reporting to `managerId` directly or indirectly, depth-first; O(reports)
+    QStringList reportsUnder(const QString& managerId) const;
+    // O(reports), O(1) with labels
+    int reportCountUnder(const QString& managerId) const;
+    // Managers from the direct one up to the top, stopping at the first that is not known
+    QStringList chainOfCommand(const QString& employeeId) const;
+    // True if `managerId` is above `employeeId` in the reporting chain; O(depth of
+    // `employeeId`), O(1) with labels
+    bool isAbove(const QString& managerId, const QString& employeeId) const;
+    // True if putting `employeeId` under `managerId` would make it report to itself. Walks up
+    // from `managerId` in O(depth), so checking an edit does not force a relabel.
+    bool wouldCreateCycle(const QString& employeeId, const QString& managerId) const;
+
+private:
+    static constexpr qint32 None = -1;
+
+    qint32 nodeOf(const QString& id) const;
+    qint32 ensureNode(const QString& id);
+    void attach(qint32 node, qint32 parent);
+    void detach(qint32 node);
+    // Frees placeholders once nothing points at them any more
+    void releaseIfUnused(qint32 node);
+    void invalidateLabels();
+    // True if the labels can answer a query, rebuilding them if walks have earned it
+    bool labelsReady() const;
+    void ensureLabels() const;
+    void label(qint32 root) const;
+    // Appends the reports under `root` to `ids`, if given, and returns how many there are
+    qint32 walkReports(qint32 root, QStringList* ids) const;
+    bool isAboveNode(qint32 ancestor, qint32 node) const;
+
+    QList<CompactId> m_ids;
+    QList<qint32> m_parent;
+    QList<QList<qint32>> m_children;
+    // Where each node sits in its parent's m_children, so it can be swap-removed
+    QList<qint32> m_childSlot;
+    // 0 for placeholders of managers that are not employees
+    QList<quint8> m_present;
+    QHash<CompactId, qint32> m_nodeById;
+    QList<qint32> m_freeNodes;
+
+    mutable bool m_labelsValid = true;
+    // Nodes the queries have walked since the labels were dropped
+    mutable qsizetype m_walkedSinceEdit = 0;
+    // Nodes in depth-first order; a node's subtree follows it in m_order
+    mutable QList<qint32> m_order;
+    mutable QList<qint32> m_enter;
+    mutable QList<qint32> m_subtreeSize;
+};
+
+#endif // MANAGERHIERARCHY_H
@@ -0,0 +1,53 @@
+#ifndef PAYROLLENGINE_H
+#define PAYROLLENGINE_H
+
+#include "models/employee.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+// Headcount and base salary cost per department and per salary grade, kept up to date
+// from individual employee and grade changes instead of being recomputed from the lists.
+// Only active employees are counted; the employee list the app loads holds no others.
+// Employees without a department or grade are grouped under an empty id, and grades whose
+// salary is unknown contribute nothing.
+class PayrollEngine {
+public:
+    struct Totals {
+        int headcount = 0;
+        double totalSalary = 0.0;
+
+        double meanSalary() const { return headcount > 0 ? totalSalary / headcount : 0.0; }
+        bool isEmpty() const { return headcount == 0; }
+    };
+
+    void addEmployee(const Employee& employee);
+    void removeEmployee(const Employee& employee);
+    // Returns the departments whose totals changed. Only the departments that have active
+    // employees in the grade are visited.
+    QStringList setBaseSalary(const QString& gradeId, double baseSalary);
+    QStringList removeGrade(const QString& gradeId);
+    void clear();
+
+    // Empty totals for ids nobody is in
+    Totals departmentTotals(const QString& departmentId) const {
+        return m_departments.value(departmentId);
+    }
+    Totals gradeTotals(const QString& gradeId) const { return m_grades.value(gradeId); }
+    QStringList departmentIds() const { return m_departments.keys(); }
+    QStringList gradeIds() const { return m_grades.keys(); }
+
+private:
+    void apply(const Employee& employee, int sign);
+    static void adjust(QHash<QString, Totals>& totals, const QString& id, double salary,
+                       int sign);
+
+    QHash<QString, Totals> m_departments;
+    QHash<QString, Totals> m_grades;
+    QHash<QString, double> m_baseSalaries;
+    // Active employees by grade, then department
+    QHash<QString, QHash<QString, int>> m_activeByGrade;
+};
+
+#endif // PAYROLLENGINE_H
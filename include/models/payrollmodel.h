@@ -0,0 +1,88 @@
+#ifndef PAYROLLMODEL_H
+#define PAYROLLMODEL_H
+
+#include "models/payrollengine.h"
+#include "models/salarygrade.h"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+class DepartmentListModel;
+class EmployeeListModel;
+class SalaryGradeListModel;
+
+// Payroll totals per department or per salary grade, one row per group with employees.
+// The totals follow every employee and grade change of the attached models through a
+// PayrollEngine. Row updates are collected and applied once control returns to the event
+// loop, so a full list refresh does not repaint the rows once per employee.
+class PayrollModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(GroupBy groupBy READ groupBy WRITE setGroupBy NOTIFY groupByChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum GroupBy { ByDepartment, BySalaryGrade };
+    Q_ENUM(GroupBy)
+
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        // Department name or grade code; empty for the group without one
+        NameRole,
+        HeadcountRole,
+        TotalSalaryRole,
+        MeanSalaryRole
+    };
+
+    explicit PayrollModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    GroupBy groupBy() const { return m_groupBy; }
+    void setGroupBy(GroupBy groupBy);
+    int count() const { return rowCount(); }
+
+    const PayrollEngine& engine() const { return m_engine; }
+
+    void setEmployeeModel(EmployeeListModel* model);
+    void setSalaryGradeModel(SalaryGradeListModel* model);
+    // Only used for the department names
+    void setDepartmentModel(DepartmentListModel* model);
+
+signals:
+    void groupByChanged();
+    void countChanged();
+
+private:
+    void rebuild();
+    void onEmployeeAdded(const Employee& employee);
+    void onEmployeeRemoved(const Employee& employee);
+    void onGradeAdded(const SalaryGrade& grade);
+    void onGradeRemoved(const SalaryGrade& grade);
+    void markDirty(GroupBy group, const QString& id);
+    void markDirty(GroupBy group, const QStringList& ids);
+    void flush();
+    void notifyNames();
+    PayrollEngine::Totals totalsOf(const QString& id) const;
+
+    PayrollEngine m_engine;
+    GroupBy m_groupBy = ByDepartment;
+    QStringList m_rowIds;
+    // Groups of the current grouping whose row has to be updated, added or dropped
+    QSet<QString> m_dirtyIds;
+    QTimer* m_flushTimer;
+    // Kept from the grade signals, so names never have to be looked up in the grade model
+    // while it is in the middle of an update
+    QHash<QString, QString> m_gradeCodes;
+
+    QPointer<EmployeeListModel> m_employeeModel;
+    QPointer<SalaryGradeListModel> m_salaryGradeModel;
+    QPointer<DepartmentListModel> m_departmentModel;
+};
+
+#endif // PAYROLLMODEL_H
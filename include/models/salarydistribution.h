@@ -0,0 +1,43 @@
+#ifndef SALARYDISTRIBUTION_H
+#define SALARYDISTRIBUTION_H
+
+#include <QList>
+#include <QtGlobal>
+
+#include <cmath>
+
+// Summary of a set of salaries: count, mean, variance, extremes and the 10th, 50th and
+// 90th percentile. The kernels work on plain contiguous double arrays. The reductions run
+// four independent accumulators, which lets the compiler keep them in SIMD registers
+// without relaxing floating-point semantics. Percentiles come from selection
+// (std::nth_element) rather than a sort, so a summary is O(n).
+struct SalaryDistribution {
+    int count = 0;
+    double mean = 0.0;
+    // Population variance
+    double variance = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p10 = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+
+    double stdDev() const { return std::sqrt(variance); }
+
+    // Reorders `values`
+    static SalaryDistribution of(double* values, qsizetype count);
+    // Counts per equal-width bin over [min, max]; values outside go to the first or last bin
+    static QList<int> histogram(const double* values, qsizetype count, double min, double max,
+                                int bins);
+
+    static double sum(const double* values, qsizetype count);
+    static double sumOfSquaredDeviations(const double* values, qsizetype count, double mean);
+    static void minMax(const double* values, qsizetype count, double& min, double& max);
+    // Fills `results` with the `fractions` (ascending, in [0, 1]) percentiles, linearly
+    // interpolated between the closest ranks. Each selection only searches the part of
+    // the array the previous one left above it. Reorders `values`.
+    static void percentiles(double* values, qsizetype count, const double* fractions,
+                            int fractionCount, double* results);
+};
+
+#endif // SALARYDISTRIBUTION_H
@@ -23,6 +23,9 @@ public:
 
     static SalaryGrade fromJson(const QJsonObject& json);
     QJsonObject toJson() const;
+
+    bool operator==(const SalaryGrade& other) const;
+    bool operator!=(const SalaryGrade& other) const { return !(*this == other); }
 };
 
 Q_DECLARE_METATYPE(SalaryGrade)
@@ -0,0 +1,38 @@
+#ifndef SALARYGRADELISTMODEL_H
+#define SALARYGRADELISTMODEL_H
+
+#include "models/keyedlistmodel.h"
+#include "models/salarygrade.h"
+
+class SalaryGradeListModel : public KeyedListModel<SalaryGrade> {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles { IdRole = Qt::UserRole + 1, CodeRole, BaseSalaryRole, DescriptionRole, LabelRole };
+
+    explicit SalaryGradeListModel(QObject* parent = nullptr);
+
+    int count() const { return rowCount(); }
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE int indexOfId(const QString& id) const { return rowOfId(id); }
+    Q_INVOKABLE QString codeOf(const QString& id) const;
+    // "CODE - $salary", the form used wherever a grade is shown next to an employee
+    Q_INVOKABLE QString labelOf(const QString& id) const;
+
+    static QString label(const SalaryGrade& grade);
+
+signals:
+    void countChanged();
+    // Same contract as EmployeeListModel::employeeAdded() / employeeRemoved()
+    void gradeAdded(const SalaryGrade& grade);
+    void gradeRemoved(const SalaryGrade& grade);
+
+protected:
+    QVariant dataForRole(const SalaryGrade& grade, int role) const override;
+    void itemAdded(const SalaryGrade& grade) override { emit gradeAdded(grade); }
+    void itemRemoved(const SalaryGrade& grade) override { emit gradeRemoved(grade); }
+};
+
+#endif // SALARYGRADELISTMODEL_H
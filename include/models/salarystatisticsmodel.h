@@ -0,0 +1,113 @@
+#ifndef SALARYSTATISTICSMODEL_H
+#define SALARYSTATISTICSMODEL_H
+
+#include "models/salarydistribution.h"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+
+class DepartmentListModel;
+class EmployeeListModel;
+class SalaryGradeListModel;
+
+// Salary distribution of the active employees, each paid their grade's base salary, for
+// the whole organization and per department or grade. Employees whose grade is unknown
+// are left out. The figures are recomputed from EmployeeListModel::columns() shortly after
+// the employees or grades change.
+//
+// The what-if overrides replace grades' base salaries in these statistics only, and take
+// effect immediately, so an edit can be previewed before it is saved.
+class SalaryStatisticsModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(GroupBy groupBy READ groupBy WRITE setGroupBy NOTIFY groupByChanged)
+    Q_PROPERTY(int binCount READ binCount WRITE setBinCount NOTIFY binCountChanged)
+    // count, mean, stdDev, min, max, p10, p50, p90 and histogram for everyone
+    Q_PROPERTY(QVariantMap organization READ organization NOTIFY statisticsChanged)
+    Q_PROPERTY(bool whatIfActive READ whatIfActive NOTIFY statisticsChanged)
+
+public:
+    enum GroupBy { ByDepartment, BySalaryGrade };
+    Q_ENUM(GroupBy)
+
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        NameRole,
+        CountRole,
+        MeanRole,
+        VarianceRole,
+        StdDevRole,
+        MinRole,
+        MaxRole,
+        P10Role,
+        P50Role,
+        P90Role,
+        // Counts over the organization's salary range, so groups can be compared
+        HistogramRole
+    };
+
+    static constexpr int DefaultBinCount = 10;
+
+    explicit SalaryStatisticsModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    GroupBy groupBy() const { return m_groupBy; }
+    void setGroupBy(GroupBy groupBy);
+    int binCount() const { return m_binCount; }
+    void setBinCount(int bins);
+
+    QVariantMap organization() const;
+    const SalaryDistribution& organizationDistribution() const { return m_organization; }
+    bool whatIfActive() const { return !m_whatIfSalaries.isEmpty(); }
+
+    Q_INVOKABLE void setWhatIfSalary(const QString& gradeId, double baseSalary);
+    Q_INVOKABLE void clearWhatIf();
+
+    void setEmployeeModel(EmployeeListModel* model);
+    void setSalaryGradeModel(SalaryGradeListModel* model);
+    // Only used for the department names
+    void setDepartmentModel(DepartmentListModel* model);
+
+    // Recomputes right away instead of waiting for the pending update
+    void recompute();
+
+signals:
+    void groupByChanged();
+    void binCountChanged();
+    void statisticsChanged();
+
+private:
+    struct Group {
+        QString id;
+        SalaryDistribution distribution;
+        QList<int> histogram;
+    };
+
+    void scheduleRecompute();
+    static QVariantMap toMap(const SalaryDistribution& distribution, const QList<int>& histogram);
+
+    GroupBy m_groupBy = ByDepartment;
+    int m_binCount = DefaultBinCount;
+    QHash<QString, double> m_whatIfSalaries;
+    QTimer* m_recomputeTimer;
+
+    SalaryDistribution m_organization;
+    QList<int> m_organizationHistogram;
+    QList<Group> m_groups;
+    // Scratch buffers, kept to avoid reallocating them on every recompute
+    QList<double> m_values;
+    QList<double> m_organizationValues;
+
+    QPointer<EmployeeListModel> m_employeeModel;
+    QPointer<SalaryGradeListModel> m_salaryGradeModel;
+    QPointer<DepartmentListModel> m_departmentModel;
+};
+
+#endif // SALARYSTATISTICSMODEL_H
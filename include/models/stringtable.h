@@ -0,0 +1,34 @@
+#ifndef STRINGTABLE_H
+#define STRINGTABLE_H
+
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QString>
+
+// Append-only pool that hands out a small index per distinct string, so values repeated
+// across many entities are stored once and compared as integers. Index 0 is always the
+// empty string. Safe to use from the threads that decode responses.
+class StringTable {
+public:
+    StringTable();
+
+    // Employee::role values
+    static StringTable& roles();
+    // Ids that are not canonical UUIDs, see CompactId
+    static StringTable& ids();
+
+    quint32 intern(const QString& text);
+    // -1 if `text` was never interned
+    qint64 indexOf(const QString& text) const;
+    // Empty for an index this table never handed out
+    QString at(quint32 index) const;
+    int size() const;
+
+private:
+    mutable QReadWriteLock m_lock;
+    QList<QString> m_strings;
+    QHash<QString, quint32> m_indices;
+};
+
+#endif // STRINGTABLE_H
@@ -1,18 +1,20 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import PersonnelManagement 1.0
 
 Item {
     id: root
 
     property var colorScheme
-    property var employees: []
+    property var employeeModel: null
     property string selectedEmployeeId: ""
     property string placeholderText: "Select employee..."
     property bool showRole: true
-
-    // Trigger to force model refresh
-    property int refreshTrigger: 0
+    // Optional constraints on the offered employees (empty for none)
+    property string roleFilter: ""
+    property string departmentFilter: ""
+    property int maxResults: 50
 
     // Default colors for when colorScheme is undefined
     readonly property color defaultPrimary: "#D0BCFF"
@@ -32,11 +34,6 @@ Item {
     function getOutline() { return root.colorScheme ? root.colorScheme.outline : defaultOutline }
     function getPrimaryContainer() { return root.colorScheme ? root.colorScheme.primaryContainer : defaultPrimaryContainer }
 
-    // Watch for employee changes
-    onEmployeesChanged: {
-        refreshTrigger++
-    }
-
     implicitHeight: 48
     implicitWidth: 200
 
@@ -44,15 +41,11 @@ Item {
 
     // Get display text for current selection
     function getDisplayText() {
-        if (!root.selectedEmployeeId || root.selectedEmployeeId === "") {
+        if (!root.selectedEmployeeId || root.selectedEmployeeId === "" || !root.employeeModel) {
             return "None"
         }
-        for (var i = 0; i < root.employees.length; i++) {
-            if (root.employees[i].id === root.selectedEmployeeId) {
-                return root.employees[i].firstName + " " + root.employees[i].lastName
-            }
-        }
-        return "None"
+        var name = root.employeeModel.fullNameOf(root.selectedEmployeeId)
+        return name !== "" ? name : "None"
     }
 
     // Set selection by employee ID
@@ -73,26 +66,22 @@ Item {
         return role.replace(/([A-Z])/g, ' $1').trim()
     }
 
-    // Filter employees based on search text
-    function getFilteredEmployees() {
-        var searchText = searchField.text.toLowerCase()
-        var filtered = []
-
-        // Always add "None" option first
-        filtered.push({ id: "", firstName: "None", lastName: "", role: "" })
-
-        if (!root.employees) return filtered
-
-        for (var i = 0; i < root.employees.length; i++) {
-            var emp = root.employees[i]
-            var fullName = (emp.firstName + " " + emp.lastName).toLowerCase()
-            var role = (emp.role || "").toLowerCase()
+    // Best matches from the shared employee index, only computed while the popup is open
+    EmployeeCompletionModel {
+        id: completions
+        employeeModel: root.employeeModel
+        query: searchField.text
+        roleFilter: root.roleFilter
+        departmentFilter: root.departmentFilter
+        limit: root.maxResults
+        active: popup.visible
+    }
 
-            if (searchText === "" || fullName.indexOf(searchText) >= 0 || role.indexOf(searchText) >= 0) {
-                filtered.push(emp)
-            }
-        }
-        return filtered
+    // Select an entry and close the popup
+    function choose(empId) {
+        root.selectedEmployeeId = empId
+        root.employeeSelected(empId)
+        popup.close()
     }
 
     // Main button that shows current selection
@@ -112,7 +101,10 @@ Item {
 
             Text {
                 Layout.fillWidth: true
-                text: root.getDisplayText()
+                text: {
+                    var dummy = root.employeeModel ? root.employeeModel.count : 0  // Re-resolve once loaded
+                    return root.getDisplayText()
+                }
                 font.pixelSize: 14
                 color: getTextOnSurface()
                 elide: Text.ElideRight
@@ -250,11 +242,7 @@ Item {
                         id: listView
                         anchors.fill: parent
                         clip: true
-                        // Model depends on refreshTrigger to force updates when employees change
-                        model: {
-                            var dummy = root.refreshTrigger  // Force re-evaluation
-                            return root.getFilteredEmployees()
-                        }
+                        model: completions
                         boundsBehavior: Flickable.StopAtBounds
 
                         ScrollBar.vertical: ScrollBar {
@@ -262,14 +250,62 @@ Item {
                             policy: listView.contentHeight > listView.height ? ScrollBar.AlwaysOn : ScrollBar.AsNeeded
                         }
 
+                        // "None" entry, always shown first
+                        header: Rectangle {
+                            id: noneItem
+                            width: listView.width - (listView.ScrollBar.vertical.visible ? 12 : 0)
+                            height: 52
+                            radius: 4
+
+                            property bool isSelected: root.selectedEmployeeId === ""
+
+                            color: {
+                                if (isSelected) {
+                                    return getPrimaryContainer()
+                                } else if (noneMouseArea.containsMouse) {
+                                    return Qt.rgba(0.5, 0.5, 0.5, 0.1)
+                                }
+                                return "transparent"
+                            }
+
+                            RowLayout {
+                                anchors.fill: parent
+                                anchors.leftMargin: 12
+                                anchors.rightMargin: 12
+                                spacing: 8
+
+                                Text {
+                                    Layout.fillWidth: true
+                                    text: "None"
+                                    font.pixelSize: 14
+                                    font.weight: noneItem.isSelected ? Font.Medium : Font.Normal
+                                    color: getTextOnSurface()
+                                    elide: Text.ElideRight
+                                }
+
+                                Text {
+                                    text: "✓"
+                                    font.pixelSize: 14
+                                    color: getPrimary()
+                                    visible: noneItem.isSelected
+                                }
+                            }
+
+                            MouseArea {
+                                id: noneMouseArea
+                                anchors.fill: parent
+                                hoverEnabled: true
+                                onClicked: root.choose("")
+                            }
+                        }
+
                         delegate: Rectangle {
                             id: delegateItem
                             width: listView.width - (listView.ScrollBar.vertical.visible ? 12 : 0)
                             height: 52
                             radius: 4
 
-                            property bool isNone: modelData.id === ""
-                            property bool isSelected: modelData.id === root.selectedEmployeeId
+                            property bool isSelected: model.id === root.selectedEmployeeId
 
                             color: {
                                 if (isSelected) {
@@ -292,7 +328,7 @@ Item {
 
                                     Text {
                                         width: parent.width
-                                        text: delegateItem.isNone ? "None" : (modelData.firstName + " " + modelData.lastName)
+                                        text: model.fullName
                                         font.pixelSize: 14
                                         font.weight: delegateItem.isSelected ? Font.Medium : Font.Normal
                                         color: getTextOnSurface()
@@ -302,11 +338,11 @@ Item {
                                     // Role display in light grey
                                     Text {
                                         width: parent.width
-                                        text: root.formatRole(modelData.role)
+                                        text: root.formatRole(model.role)
                                         font.pixelSize: 12
                                         color: getTextOnSurfaceVariant()
                                         elide: Text.ElideRight
-                                        visible: root.showRole && !delegateItem.isNone && modelData.role
+                                        visible: root.showRole && model.role !== ""
                                         opacity: 0.7
                                     }
                                 }
@@ -324,11 +360,7 @@ Item {
                                 id: delegateMouseArea
                                 anchors.fill: parent
                                 hoverEnabled: true
-                                onClicked: {
-                                    root.selectedEmployeeId = modelData.id
-                                    root.employeeSelected(modelData.id)
-                                    popup.close()
-                                }
+                                onClicked: root.choose(model.id)
                             }
                         }
                     }
@@ -343,7 +375,17 @@ Item {
                     color: getTextOnSurfaceVariant()
                     horizontalAlignment: Text.AlignHCenter
                     verticalAlignment: Text.AlignVCenter
-                    visible: root.getFilteredEmployees().length <= 1 && searchField.text !== ""
+                    visible: completions.count === 0 && searchField.text !== ""
+                }
+
+                // Only the best matches are listed
+                Text {
+                    width: parent.width
+                    text: "Type to narrow down the list"
+                    font.pixelSize: 12
+                    color: getTextOnSurfaceVariant()
+                    horizontalAlignment: Text.AlignHCenter
+                    visible: completions.truncated
                 }
             }
         }
@@ -1,17 +1,20 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import PersonnelManagement 1.0
 import "../components"
 import "../dialogs"
 
-Flickable {
+ListView {
     id: root
     property var colorScheme
     property string searchQuery: ""
 
-    // Essential for scrolling on Windows
-    contentHeight: contentColumn.height
-    contentWidth: width
+    // Cards exist only for rows in view and are recycled while scrolling
+    model: departmentFilter
+    spacing: 12
+    reuseItems: true
+    cacheBuffer: 480
     clip: true
     boundsBehavior: Flickable.StopAtBounds
     flickableDirection: Flickable.VerticalFlick
@@ -22,29 +25,19 @@ Flickable {
         active: true
     }
 
-    // Filter departments based on search query
-    function getFilteredDepartments() {
-        if (!personnelApp) return []
-        var depts = personnelApp.departments
-        if (!searchQuery || searchQuery.trim() === "") return depts
-
-        var query = searchQuery.toLowerCase()
-        var filtered = []
-        for (var i = 0; i < depts.length; i++) {
-            var dept = depts[i]
-            var name = (dept.name || "").toLowerCase()
-            var headName = dept.headId ? getEmployeeName(dept.headId).toLowerCase() : ""
-            if (name.indexOf(query) >= 0 || headName.indexOf(query) >= 0) {
-                filtered.push(dept)
-            }
-        }
-        return filtered
+    // Filtered view over the department model (matching happens in C++)
+    DepartmentFilterModel {
+        id: departmentFilter
+        sourceModel: personnelApp ? personnelApp.departmentModel : null
+        employeeModel: personnelApp ? personnelApp.employeeModel : null
+        filterText: root.searchQuery
     }
 
-    Column {
-        id: contentColumn
+    // Title, search and result count scroll along with the list
+    header: Column {
         width: root.width
         spacing: 12
+        bottomPadding: 12
 
         // Header with title and add button
         RowLayout {
@@ -148,162 +141,145 @@ Flickable {
         // Results count
         Text {
             text: {
-                var filtered = getFilteredDepartments()
-                var total = personnelApp ? personnelApp.departments.length : 0
+                var total = personnelApp ? personnelApp.departmentModel.count : 0
                 if (searchQuery && searchQuery.trim() !== "") {
-                    return filtered.length + " of " + total + " departments"
+                    return departmentFilter.count + " of " + total + " departments"
                 }
                 return total + " departments"
             }
             font.pixelSize: 12
             color: colorScheme.textOnSurfaceVariant
         }
+    }
+
+    // Department list
+    delegate: MaterialCard {
+        width: ListView.view.width
+        height: 120
+        colorScheme: root.colorScheme
 
-        // Department list
-        Repeater {
-            model: getFilteredDepartments()
+        RowLayout {
+            anchors.fill: parent
+            anchors.rightMargin: 16
+            anchors.leftMargin: 16
+            anchors.topMargin: 16
+            anchors.bottomMargin: 16
+            spacing: 20
 
-            MaterialCard {
-                width: parent.width
-                height: 120
-                colorScheme: root.colorScheme
+            Column {
+                Layout.fillWidth: true
+                spacing: 10
+
+                Text {
+                    text: model.name
+                    font.pixelSize: 18
+                    font.bold: true
+                    color: colorScheme.textOnSurface
+                }
 
                 RowLayout {
-                    anchors.fill: parent
-                    anchors.rightMargin: 16
-                    anchors.leftMargin: 16
-                    anchors.topMargin: 16
-                    anchors.bottomMargin: 16
-                    spacing: 20
+                    spacing: 6
 
-                    Column {
-                        Layout.fillWidth: true
-                        spacing: 10
+                    MaterialIcon {
+                        icon: "person"
+                        iconColor: colorScheme.textOnSurfaceVariant
+                        size: 16
+                    }
 
-                        Text {
-                            text: modelData.name
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: colorScheme.textOnSurface
-                        }
+                    Text {
+                        text: model.headId ? (model.headName || "Unknown") : "No head assigned"
+                        font.pixelSize: 13
+                        color: colorScheme.textOnSurfaceVariant
+                    }
+                }
+            }
 
-                        RowLayout {
-                            spacing: 6
+            Row {
+                spacing: 12
+                Layout.rightMargin: 8
 
-                            MaterialIcon {
-                                icon: "person"
-                                iconColor: colorScheme.textOnSurfaceVariant
-                                size: 16
-                            }
+                Button {
+                    implicitWidth: 90
+                    implicitHeight: 36
 
-                            Text {
-                                text: modelData.headId ? getEmployeeName(modelData.headId) : "No head assigned"
-                                font.pixelSize: 13
-                                color: colorScheme.textOnSurfaceVariant
-                            }
-                        }
+                    background: Rectangle {
+                        color: parent.hovered ? colorScheme.primaryContainer : "transparent"
+                        radius: 8
+                        border.width: 1
+                        border.color: colorScheme.primary
                     }
 
-                    Row {
-                        spacing: 12
-                        Layout.rightMargin: 8
+                    contentItem: RowLayout {
+                        spacing: 6
 
-                        Button {
-                            implicitWidth: 90
-                            implicitHeight: 36
+                        MaterialIcon {
+                            icon: "edit"
+                            iconColor: colorScheme.primary
+                            size: 16
+                            Layout.alignment: Qt.AlignVCenter
+                        }
 
-                            background: Rectangle {
-                                color: parent.hovered ? colorScheme.primaryContainer : "transparent"
-                                radius: 8
-                                border.width: 1
-                                border.color: colorScheme.primary
-                            }
+                        Text {
+                            text: "Edit"
+                            color: colorScheme.primary
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            font.pixelSize: 14
+                            font.weight: Font.Medium
+                            Layout.alignment: Qt.AlignVCenter
+                        }
+                    }
 
-                            contentItem: RowLayout {
-                                spacing: 6
-
-                                MaterialIcon {
-                                    icon: "edit"
-                                    iconColor: colorScheme.primary
-                                    size: 16
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-
-                                Text {
-                                    text: "Edit"
-                                    color: colorScheme.primary
-                                    horizontalAlignment: Text.AlignHCenter
-                                    verticalAlignment: Text.AlignVCenter
-                                    font.pixelSize: 14
-                                    font.weight: Font.Medium
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-                            }
+                    onClicked: {
+                        editDepartmentDialog.departmentId = model.id
+                        editDepartmentDialog.departmentName = model.name
+                        editDepartmentDialog.departmentHeadId = model.headId || ""
+                        editDepartmentDialog.open()
+                    }
+                }
 
-                            onClicked: {
-                                editDepartmentDialog.departmentId = modelData.id
-                                editDepartmentDialog.departmentName = modelData.name
-                                editDepartmentDialog.departmentHeadId = modelData.headId || ""
-                                editDepartmentDialog.open()
-                            }
-                        }
+                Button {
+                    implicitWidth: 100
+                    implicitHeight: 36
 
-                        Button {
-                            implicitWidth: 100
-                            implicitHeight: 36
+                    background: Rectangle {
+                        color: parent.hovered ? "#3D1616" : "transparent"
+                        radius: 8
+                        border.width: 1
+                        border.color: colorScheme.error
+                    }
 
-                            background: Rectangle {
-                                color: parent.hovered ? "#3D1616" : "transparent"
-                                radius: 8
-                                border.width: 1
-                                border.color: colorScheme.error
-                            }
+                    contentItem: RowLayout {
+                        spacing: 6
 
-                            contentItem: RowLayout {
-                                spacing: 6
-
-                                MaterialIcon {
-                                    icon: "delete"
-                                    iconColor: colorScheme.error
-                                    size: 16
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-
-                                Text {
-                                    text: "Delete"
-                                    color: colorScheme.error
-                                    horizontalAlignment: Text.AlignHCenter
-                                    verticalAlignment: Text.AlignVCenter
-                                    font.pixelSize: 14
-                                    font.weight: Font.Medium
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-                            }
+                        MaterialIcon {
+                            icon: "delete"
+                            iconColor: colorScheme.error
+                            size: 16
+                            Layout.alignment: Qt.AlignVCenter
+                        }
 
-                            onClicked: {
-                                if (personnelApp) {
-                                    confirmDeleteDialog.departmentId = modelData.id
-                                    confirmDeleteDialog.departmentName = modelData.name
-                                    confirmDeleteDialog.open()
-                                }
-                            }
+                        Text {
+                            text: "Delete"
+                            color: colorScheme.error
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            font.pixelSize: 14
+                            font.weight: Font.Medium
+                            Layout.alignment: Qt.AlignVCenter
                         }
                     }
-                }
-            }
-        }
-    }
 
-    // Helper function to get employee name by ID
-    function getEmployeeName(employeeId) {
-        if (!personnelApp || !employeeId) return "Unknown"
-        var employees = personnelApp.employees
-        for (var i = 0; i < employees.length; i++) {
-            if (employees[i].id === employeeId) {
-                return employees[i].firstName + " " + employees[i].lastName
+                    onClicked: {
+                        if (personnelApp) {
+                            confirmDeleteDialog.departmentId = model.id
+                            confirmDeleteDialog.departmentName = model.name
+                            confirmDeleteDialog.open()
+                        }
+                    }
+                }
             }
         }
-        return "Unknown"
     }
 
     // Create department dialog
@@ -396,7 +372,7 @@ Flickable {
                     id: deptHeadCombo
                     width: parent.width
                     colorScheme: root.colorScheme
-                    employees: personnelApp ? personnelApp.employees : []
+                    employeeModel: personnelApp ? personnelApp.employeeModel : null
                     showRole: true
                     placeholderText: "Select department head..."
                 }
@@ -568,7 +544,7 @@ Flickable {
                     id: editDeptHeadCombo
                     width: parent.width
                     colorScheme: root.colorScheme
-                    employees: personnelApp ? personnelApp.employees : []
+                    employeeModel: personnelApp ? personnelApp.employeeModel : null
                     showRole: true
                     placeholderText: "Select department head..."
                 }
@@ -1,17 +1,21 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import PersonnelManagement 1.0
 import "../components"
 import "../dialogs"
 
-Flickable {
+ListView {
     id: root
     property var colorScheme
     property string searchQuery: ""
 
-    // Essential for scrolling on Windows
-    contentHeight: contentColumn.height
-    contentWidth: width
+    // Only the cards in view (plus a small cache) exist at a time; cards scrolled out of
+    // view are handed to the rows scrolling in instead of being destroyed and recreated
+    model: employeeFilter
+    spacing: 12
+    reuseItems: true
+    cacheBuffer: 480
     clip: true
     boundsBehavior: Flickable.StopAtBounds
     flickableDirection: Flickable.VerticalFlick
@@ -29,35 +33,18 @@ Flickable {
         return role.replace(/([A-Z])/g, ' $1').trim()
     }
 
-    // Filter employees based on search query
-    function getFilteredEmployees() {
-        if (!personnelApp) return []
-        var emps = personnelApp.employees
-        if (!searchQuery || searchQuery.trim() === "") return emps
-
-        var query = searchQuery.toLowerCase()
-        var filtered = []
-        for (var i = 0; i < emps.length; i++) {
-            var emp = emps[i]
-            var fullName = ((emp.firstName || "") + " " + (emp.lastName || "")).toLowerCase()
-            var email = (emp.email || "").toLowerCase()
-            var role = (emp.role || "").toLowerCase()
-            var deptName = emp.departmentId ? getDepartmentName(emp.departmentId).toLowerCase() : ""
-
-            if (fullName.indexOf(query) >= 0 ||
-                email.indexOf(query) >= 0 ||
-                role.indexOf(query) >= 0 ||
-                deptName.indexOf(query) >= 0) {
-                filtered.push(emp)
-            }
-        }
-        return filtered
+    // Filtered view over the employee model (matching happens in C++)
+    EmployeeFilterModel {
+        id: employeeFilter
+        sourceModel: personnelApp ? personnelApp.employeeModel : null
+        filterText: root.searchQuery
     }
 
-    Column {
-        id: contentColumn
+    // Title, search and result count scroll along with the list
+    header: Column {
         width: root.width
         spacing: 12
+        bottomPadding: 12
 
         // Header
         RowLayout {
@@ -159,226 +146,198 @@ Flickable {
         // Results count
         Text {
             text: {
-                var filtered = getFilteredEmployees()
-                var total = personnelApp ? personnelApp.employees.length : 0
+                var total = personnelApp ? personnelApp.employeeModel.count : 0
                 if (searchQuery && searchQuery.trim() !== "") {
-                    return filtered.length + " of " + total + " employees"
+                    return employeeFilter.count + " of " + total + " employees"
                 }
                 return total + " employees"
             }
             font.pixelSize: 12
             color: colorScheme.textOnSurfaceVariant
         }
+    }
 
-        // Employee list
-        Repeater {
-            model: getFilteredEmployees()
-
-            MaterialCard {
-                width: parent.width
-                height: 160
-                colorScheme: root.colorScheme
-
-                RowLayout {
-                    anchors.fill: parent
-                    anchors.rightMargin: 16
-                    anchors.leftMargin: 16
-                    anchors.topMargin: 16
-                    anchors.bottomMargin: 16
-                    spacing: 20
+    // Employee list
+    delegate: MaterialCard {
+        width: ListView.view.width
+        height: 160
+        colorScheme: root.colorScheme
 
-                    Column {
-                        Layout.fillWidth: true
-                        spacing: 10
+        RowLayout {
+            anchors.fill: parent
+            anchors.rightMargin: 16
+            anchors.leftMargin: 16
+            anchors.topMargin: 16
+            anchors.bottomMargin: 16
+            spacing: 20
 
-                        Text {
-                            text: modelData.firstName + " " + modelData.lastName
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: colorScheme.textOnSurface
-                        }
+            Column {
+                Layout.fillWidth: true
+                spacing: 10
 
-                        RowLayout {
-                            spacing: 6
+                Text {
+                    text: model.firstName + " " + model.lastName
+                    font.pixelSize: 18
+                    font.bold: true
+                    color: colorScheme.textOnSurface
+                }
 
-                            MaterialIcon {
-                                icon: "email"
-                                iconColor: colorScheme.textOnSurfaceVariant
-                                size: 16
-                            }
+                RowLayout {
+                    spacing: 6
 
-                            Text {
-                                text: modelData.email
-                                font.pixelSize: 13
-                                color: colorScheme.textOnSurfaceVariant
-                            }
-                        }
+                    MaterialIcon {
+                        icon: "email"
+                        iconColor: colorScheme.textOnSurfaceVariant
+                        size: 16
+                    }
 
-                        RowLayout {
-                            spacing: 6
+                    Text {
+                        text: model.email
+                        font.pixelSize: 13
+                        color: colorScheme.textOnSurfaceVariant
+                    }
+                }
 
-                            MaterialIcon {
-                                icon: "work"
-                                iconColor: colorScheme.textOnSurfaceVariant
-                                size: 16
-                            }
+                RowLayout {
+                    spacing: 6
 
-                            Text {
-                                text: formatRole(modelData.role)
-                                font.pixelSize: 13
-                                color: colorScheme.textOnSurfaceVariant
-                            }
-                        }
+                    MaterialIcon {
+                        icon: "work"
+                        iconColor: colorScheme.textOnSurfaceVariant
+                        size: 16
+                    }
 
-                        RowLayout {
-                            spacing: 6
+                    Text {
+                        text: formatRole(model.role)
+                        font.pixelSize: 13
+                        color: colorScheme.textOnSurfaceVariant
+                    }
+                }
 
-                            MaterialIcon {
-                                icon: "business"
-                                iconColor: colorScheme.textOnSurfaceVariant
-                                size: 16
-                            }
+                RowLayout {
+                    spacing: 6
 
-                            Text {
-                                text: modelData.departmentId ? getDepartmentName(modelData.departmentId) : "No department"
-                                font.pixelSize: 13
-                                color: colorScheme.textOnSurfaceVariant
-                            }
-                        }
+                    MaterialIcon {
+                        icon: "business"
+                        iconColor: colorScheme.textOnSurfaceVariant
+                        size: 16
+                    }
 
-                        RowLayout {
-                            spacing: 6
+                    Text {
+                        text: model.departmentId ? (model.departmentName || "Unknown") : "No department"
+                        font.pixelSize: 13
+                        color: colorScheme.textOnSurfaceVariant
+                    }
+                }
 
-                            MaterialIcon {
-                                icon: "attach_money"
-                                iconColor: colorScheme.textOnSurfaceVariant
-                                size: 16
-                            }
+                RowLayout {
+                    spacing: 6
 
-                            Text {
-                                text: modelData.salaryGradeId ? getSalaryGradeCode(modelData.salaryGradeId) : "No grade"
-                                font.pixelSize: 13
-                                color: colorScheme.textOnSurfaceVariant
-                            }
-                        }
+                    MaterialIcon {
+                        icon: "attach_money"
+                        iconColor: colorScheme.textOnSurfaceVariant
+                        size: 16
                     }
 
-                    Row {
-                        spacing: 12
-                        Layout.rightMargin: 8
+                    Text {
+                        text: model.salaryGradeId ? (model.salaryGradeLabel || "Unknown") : "No grade"
+                        font.pixelSize: 13
+                        color: colorScheme.textOnSurfaceVariant
+                    }
+                }
+            }
 
-                        Button {
-                            implicitWidth: 90
-                            implicitHeight: 36
+            Row {
+                spacing: 12
+                Layout.rightMargin: 8
 
-                            background: Rectangle {
-                                color: parent.hovered ? colorScheme.primaryContainer : "transparent"
-                                radius: 8
-                                border.width: 1
-                                border.color: colorScheme.primary
-                            }
+                Button {
+                    implicitWidth: 90
+                    implicitHeight: 36
 
-                            contentItem: RowLayout {
-                                spacing: 6
+                    background: Rectangle {
+                        color: parent.hovered ? colorScheme.primaryContainer : "transparent"
+                        radius: 8
+                        border.width: 1
+                        border.color: colorScheme.primary
+                    }
 
-                                MaterialIcon {
-                                    icon: "edit"
-                                    iconColor: colorScheme.primary
-                                    size: 16
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
+                    contentItem: RowLayout {
+                        spacing: 6
 
-                                Text {
-                                    text: "Edit"
-                                    color: colorScheme.primary
-                                    horizontalAlignment: Text.AlignHCenter
-                                    verticalAlignment: Text.AlignVCenter
-                                    font.pixelSize: 14
-                                    font.weight: Font.Medium
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-                            }
+                        MaterialIcon {
+                            icon: "edit"
+                            iconColor: colorScheme.primary
+                            size: 16
+                            Layout.alignment: Qt.AlignVCenter
+                        }
 
-                            onClicked: {
-                                editEmployeeDialog.employeeId = modelData.id
-                                editEmployeeDialog.employeeFirstName = modelData.firstName
-                                editEmployeeDialog.employeeLastName = modelData.lastName
-                                editEmployeeDialog.employeeEmail = modelData.email
-                                editEmployeeDialog.employeeRole = modelData.role || ""
-                                editEmployeeDialog.employeeDepartmentId = modelData.departmentId || ""
-                                editEmployeeDialog.employeeManagerId = modelData.managerId || ""
-                                editEmployeeDialog.employeeSalaryGradeId = modelData.salaryGradeId || ""
-                                editEmployeeDialog.open()
-                            }
+                        Text {
+                            text: "Edit"
+                            color: colorScheme.primary
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            font.pixelSize: 14
+                            font.weight: Font.Medium
+                            Layout.alignment: Qt.AlignVCenter
                         }
+                    }
 
-                        Button {
-                            implicitWidth: 100
-                            implicitHeight: 36
+                    onClicked: {
+                        editEmployeeDialog.employeeId = model.id
+                        editEmployeeDialog.employeeFirstName = model.firstName
+                        editEmployeeDialog.employeeLastName = model.lastName
+                        editEmployeeDialog.employeeEmail = model.email
+                        editEmployeeDialog.employeeRole = model.role || ""
+                        editEmployeeDialog.employeeDepartmentId = model.departmentId || ""
+                        editEmployeeDialog.employeeManagerId = model.managerId || ""
+                        editEmployeeDialog.employeeSalaryGradeId = model.salaryGradeId || ""
+                        editEmployeeDialog.open()
+                    }
+                }
 
-                            background: Rectangle {
-                                color: parent.hovered ? "#3D1616" : "transparent"
-                                radius: 8
-                                border.width: 1
-                                border.color: colorScheme.error
-                            }
+                Button {
+                    implicitWidth: 100
+                    implicitHeight: 36
 
-                            contentItem: RowLayout {
-                                spacing: 6
+                    background: Rectangle {
+                        color: parent.hovered ? "#3D1616" : "transparent"
+                        radius: 8
+                        border.width: 1
+                        border.color: colorScheme.error
+                    }
 
-                                MaterialIcon {
-                                    icon: "delete"
-                                    iconColor: colorScheme.error
-                                    size: 16
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
+                    contentItem: RowLayout {
+                        spacing: 6
 
-                                Text {
-                                    text: "Delete"
-                                    color: colorScheme.error
-                                    horizontalAlignment: Text.AlignHCenter
-                                    verticalAlignment: Text.AlignVCenter
-                                    font.pixelSize: 14
-                                    font.weight: Font.Medium
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-                            }
+                        MaterialIcon {
+                            icon: "delete"
+                            iconColor: colorScheme.error
+                            size: 16
+                            Layout.alignment: Qt.AlignVCenter
+                        }
 
-                            onClicked: {
-                                if (personnelApp) {
-                                    confirmDeleteDialog.employeeId = modelData.id
-                                    confirmDeleteDialog.employeeName = modelData.firstName + " " + modelData.lastName
-                                    confirmDeleteDialog.open()
-                                }
-                            }
+                        Text {
+                            text: "Delete"
+                            color: colorScheme.error
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            font.pixelSize: 14
+                            font.weight: Font.Medium
+                            Layout.alignment: Qt.AlignVCenter
                         }
                     }
-                }
-            }
-        }
-    }
 
-    // Helper functions to resolve IDs
-    function getDepartmentName(deptId) {
-        if (!personnelApp || !deptId) return "Unknown"
-        var departments = personnelApp.departments
-        for (var i = 0; i < departments.length; i++) {
-            if (departments[i].id === deptId) {
-                return departments[i].name
-            }
-        }
-        return "Unknown"
-    }
-
-    function getSalaryGradeCode(gradeId) {
-        if (!personnelApp || !gradeId) return "Unknown"
-        var grades = personnelApp.salaryGrades
-        for (var i = 0; i < grades.length; i++) {
-            if (grades[i].id === gradeId) {
-                return grades[i].code + " - $" + grades[i].baseSalary.toFixed(0)
+                    onClicked: {
+                        if (personnelApp) {
+                            confirmDeleteDialog.employeeId = model.id
+                            confirmDeleteDialog.employeeName = model.firstName + " " + model.lastName
+                            confirmDeleteDialog.open()
+                        }
+                    }
+                }
             }
         }
-        return "Unknown"
     }
 
     // Create employee dialog
@@ -613,28 +572,14 @@ Flickable {
             editEmpEmail.text = employeeEmail
             editEmpRole.text = employeeRole
 
-            // Set department dropdown
-            var departments = personnelApp.departments
-            editEmpDepartmentCombo.currentIndex = 0
-            for (var i = 0; i < departments.length; i++) {
-                if (departments[i].id === employeeDepartmentId) {
-                    editEmpDepartmentCombo.currentIndex = i + 1
-                    break
-                }
-            }
+            // Set department dropdown (-1 shows "None")
+            editEmpDepartmentCombo.currentIndex = editEmpDepartmentCombo.indexOfValue(employeeDepartmentId)
 
             // Set manager dropdown using SearchableEmployeeComboBox
             editEmpManagerCombo.setSelectedId(employeeManagerId)
 
-            // Set salary grade dropdown
-            var grades = personnelApp.salaryGrades
-            editEmpGradeCombo.currentIndex = 0
-            for (var k = 0; k < grades.length; k++) {
-                if (grades[k].id === employeeSalaryGradeId) {
-                    editEmpGradeCombo.currentIndex = k + 1
-                    break
-                }
-            }
+            // Set salary grade dropdown (-1 shows "None")
+            editEmpGradeCombo.currentIndex = editEmpGradeCombo.indexOfValue(employeeSalaryGradeId)
         }
 
         Column {
@@ -768,16 +713,10 @@ Flickable {
                     width: parent.width
                     implicitHeight: 48
 
-                    model: {
-                        var items = ["None"]
-                        if (personnelApp) {
-                            var depts = personnelApp.departments
-                            for (var i = 0; i < depts.length; i++) {
-                                items.push(depts[i].name)
-                            }
-                        }
-                        return items
-                    }
+                    model: personnelApp ? personnelApp.departmentModel : null
+                    textRole: "name"
+                    valueRole: "id"
+                    displayText: currentIndex < 0 ? "None" : currentText
 
                     background: Rectangle {
                         color: colorScheme.surfaceVariant
@@ -800,7 +739,7 @@ Flickable {
                         width: editEmpDepartmentCombo.width
                         height: 40
                         contentItem: Text {
-                            text: modelData
+                            text: model.name
                             color: colorScheme.textOnSurface
                             font.pixelSize: 14
                             elide: Text.ElideRight
@@ -835,6 +774,28 @@ Flickable {
                             model: editEmpDepartmentCombo.popup.visible ? editEmpDepartmentCombo.delegateModel : null
                             currentIndex: editEmpDepartmentCombo.highlightedIndex
                             ScrollIndicator.vertical: ScrollIndicator { }
+
+                            // "None" entry that clears the selection
+                            header: ItemDelegate {
+                                width: editEmpDepartmentCombo.width
+                                height: 40
+                                contentItem: Text {
+                                    text: "None"
+                                    color: colorScheme.textOnSurface
+                                    font.pixelSize: 14
+                                    elide: Text.ElideRight
+                                    verticalAlignment: Text.AlignVCenter
+                                    leftPadding: 12
+                                }
+                                background: Rectangle {
+                                    color: parent.hovered ? colorScheme.primaryContainer : "transparent"
+                                    radius: 4
+                                }
+                                onClicked: {
+                                    editEmpDepartmentCombo.currentIndex = -1
+                                    editEmpDepartmentCombo.popup.close()
+                                }
+                            }
                         }
                     }
                 }
@@ -855,7 +816,7 @@ Flickable {
                     id: editEmpManagerCombo
                     width: parent.width
                     colorScheme: root.colorScheme
-                    employees: personnelApp ? personnelApp.employees : []
+                    employeeModel: personnelApp ? personnelApp.employeeModel : null
                     showRole: true
                     placeholderText: "Select manager..."
                 }
@@ -877,16 +838,10 @@ Flickable {
                     width: parent.width
                     implicitHeight: 48
 
-                    model: {
-                        var items = ["None"]
-                        if (personnelApp) {
-                            var grds = personnelApp.salaryGrades
-                            for (var i = 0; i < grds.length; i++) {
-                                items.push(grds[i].code + " - $" + grds[i].baseSalary.toFixed(0))
-                            }
-                        }
-                        return items
-                    }
+                    model: personnelApp ? personnelApp.salaryGradeModel : null
+                    textRole: "label"
+                    valueRole: "id"
+                    displayText: currentIndex < 0 ? "None" : currentText
 
                     background: Rectangle {
                         color: colorScheme.surfaceVariant
@@ -909,7 +864,7 @@ Flickable {
                         width: editEmpGradeCombo.width
                         height: 40
                         contentItem: Text {
-                            text: modelData
+                            text: model.label
                             color: colorScheme.textOnSurface
                             font.pixelSize: 14
                             elide: Text.ElideRight
@@ -944,6 +899,28 @@ Flickable {
                             model: editEmpGradeCombo.popup.visible ? editEmpGradeCombo.delegateModel : null
                             currentIndex: editEmpGradeCombo.highlightedIndex
                             ScrollIndicator.vertical: ScrollIndicator { }
+
+                            // "None" entry that clears the selection
+                            header: ItemDelegate {
+                                width: editEmpGradeCombo.width
+                                height: 40
+                                contentItem: Text {
+                                    text: "None"
+                                    color: colorScheme.textOnSurface
+                                    font.pixelSize: 14
+                                    elide: Text.ElideRight
+                                    verticalAlignment: Text.AlignVCenter
+                                    leftPadding: 12
+                                }
+                                background: Rectangle {
+                                    color: parent.hovered ? colorScheme.primaryContainer : "transparent"
+                                    radius: 4
+                                }
+                                onClicked: {
+                                    editEmpGradeCombo.currentIndex = -1
+                                    editEmpGradeCombo.popup.close()
+                                }
+                            }
                         }
                     }
                 }
@@ -1003,13 +980,9 @@ Flickable {
                                 // Get selected IDs from dropdowns
                                 var selectedDeptId = ""
                                 var selectedDeptName = "None"
-                                if (editEmpDepartmentCombo.currentIndex > 0) {
-                                    var depts = personnelApp.departments
-                                    var deptIndex = editEmpDepartmentCombo.currentIndex - 1
-                                    if (deptIndex < depts.length) {
-                                        selectedDeptId = depts[deptIndex].id
-                                        selectedDeptName = depts[deptIndex].name
-                                    }
+                                if (editEmpDepartmentCombo.currentIndex >= 0) {
+                                    selectedDeptId = editEmpDepartmentCombo.currentValue
+                                    selectedDeptName = editEmpDepartmentCombo.currentText
                                 }
 
                                 var selectedManagerId = editEmpManagerCombo.selectedEmployeeId
@@ -1017,13 +990,9 @@ Flickable {
 
                                 var selectedGradeId = ""
                                 var selectedGradeCode = "None"
-                                if (editEmpGradeCombo.currentIndex > 0) {
-                                    var grds = personnelApp.salaryGrades
-                                    var grdIndex = editEmpGradeCombo.currentIndex - 1
-                                    if (grdIndex < grds.length) {
-                                        selectedGradeId = grds[grdIndex].id
-                                        selectedGradeCode = grds[grdIndex].code
-                                    }
+                                if (editEmpGradeCombo.currentIndex >= 0) {
+                                    selectedGradeId = editEmpGradeCombo.currentValue
+                                    selectedGradeCode = personnelApp.salaryGradeModel.codeOf(selectedGradeId)
                                 }
 
                                 // Store for confirmation
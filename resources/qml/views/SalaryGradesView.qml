@@ -4,13 +4,15 @@ import QtQuick.Layouts 1.15
 import "../components"
 import "../dialogs"
 
-Flickable {
+ListView {
     id: root
     property var colorScheme
 
-    // Essential for scrolling on Windows
-    contentHeight: contentColumn.height
-    contentWidth: width
+    // Virtualized like the other views: cards are only created for rows in view
+    model: personnelApp ? personnelApp.salaryGradeModel : null
+    spacing: 12
+    reuseItems: true
+    cacheBuffer: 480
     clip: true
     boundsBehavior: Flickable.StopAtBounds
     flickableDirection: Flickable.VerticalFlick
@@ -21,10 +23,11 @@ Flickable {
         active: true
     }
 
-    Column {
-        id: contentColumn
+    // Title and actions scroll along with the list
+    header: Column {
         width: root.width
         spacing: 12
+        bottomPadding: 12
 
         // Header
         RowLayout {
@@ -56,153 +59,149 @@ Flickable {
                 onClicked: createGradeDialog.open()
             }
         }
+    }
 
-        // Salary grade list
-        Repeater {
-            model: personnelApp ? personnelApp.salaryGrades : []
+    // Salary grade list
+    delegate: MaterialCard {
+        width: ListView.view.width
+        height: 120
+        colorScheme: root.colorScheme
 
-            MaterialCard {
-                width: parent.width
-                height: 120
-                colorScheme: root.colorScheme
+        RowLayout {
+            anchors.fill: parent
+            anchors.rightMargin: 16
+            anchors.leftMargin: 16
+            anchors.topMargin: 16
+            anchors.bottomMargin: 16
+            spacing: 20
+
+            Column {
+                Layout.fillWidth: true
+                spacing: 10
+
+                Text {
+                    text: model.code
+                    font.pixelSize: 18
+                    font.bold: true
+                    color: colorScheme.textOnSurface
+                }
 
                 RowLayout {
-                    anchors.fill: parent
-                    anchors.rightMargin: 16
-                    anchors.leftMargin: 16
-                    anchors.topMargin: 16
-                    anchors.bottomMargin: 16
-                    spacing: 20
+                    spacing: 6
 
-                    Column {
-                        Layout.fillWidth: true
-                        spacing: 10
+                    MaterialIcon {
+                        icon: "attach_money"
+                        iconColor: colorScheme.primary
+                        size: 16
+                    }
 
-                        Text {
-                            text: modelData.code
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: colorScheme.textOnSurface
-                        }
+                    Text {
+                        text: "$" + model.baseSalary.toFixed(0) + "/year"
+                        font.pixelSize: 14
+                        color: colorScheme.primary
+                        font.weight: Font.Medium
+                    }
+                }
 
-                        RowLayout {
-                            spacing: 6
+                RowLayout {
+                    spacing: 6
 
-                            MaterialIcon {
-                                icon: "attach_money"
-                                iconColor: colorScheme.primary
-                                size: 16
-                            }
+                    MaterialIcon {
+                        icon: "info"
+                        iconColor: colorScheme.textOnSurfaceVariant
+                        size: 16
+                    }
 
-                            Text {
-                                text: "$" + modelData.baseSalary.toFixed(0) + "/year"
-                                font.pixelSize: 14
-                                color: colorScheme.primary
-                                font.weight: Font.Medium
-                            }
-                        }
+                    Text {
+                        text: model.description || "No description"
+                        font.pixelSize: 13
+                        color: colorScheme.textOnSurfaceVariant
+                    }
+                }
+            }
 
-                        RowLayout {
-                            spacing: 6
+            Row {
+                spacing: 12
+                Layout.rightMargin: 8
 
-                            MaterialIcon {
-                                icon: "info"
-                                iconColor: colorScheme.textOnSurfaceVariant
-                                size: 16
-                            }
+                Button {
+                    implicitWidth: 90
+                    implicitHeight: 36
 
-                            Text {
-                                text: modelData.description || "No description"
-                                font.pixelSize: 13
-                                color: colorScheme.textOnSurfaceVariant
-                            }
-                        }
+                    background: Rectangle {
+                        color: parent.hovered ? colorScheme.primaryContainer : "transparent"
+                        radius: 8
+                        border.width: 1
+                        border.color: colorScheme.primary
                     }
 
-                    Row {
-                        spacing: 12
-                        Layout.rightMargin: 8
+                    contentItem: RowLayout {
+                        spacing: 6
 
-                        Button {
-                            implicitWidth: 90
-                            implicitHeight: 36
+                        MaterialIcon {
+                            icon: "edit"
+                            iconColor: colorScheme.primary
+                            size: 16
+                            Layout.alignment: Qt.AlignVCenter
+                        }
 
-                            background: Rectangle {
-                                color: parent.hovered ? colorScheme.primaryContainer : "transparent"
-                                radius: 8
-                                border.width: 1
-                                border.color: colorScheme.primary
-                            }
+                        Text {
+                            text: "Edit"
+                            color: colorScheme.primary
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            font.pixelSize: 14
+                            font.weight: Font.Medium
+                            Layout.alignment: Qt.AlignVCenter
+                        }
+                    }
 
-                            contentItem: RowLayout {
-                                spacing: 6
-
-                                MaterialIcon {
-                                    icon: "edit"
-                                    iconColor: colorScheme.primary
-                                    size: 16
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-
-                                Text {
-                                    text: "Edit"
-                                    color: colorScheme.primary
-                                    horizontalAlignment: Text.AlignHCenter
-                                    verticalAlignment: Text.AlignVCenter
-                                    font.pixelSize: 14
-                                    font.weight: Font.Medium
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-                            }
+                    onClicked: {
+                        editGradeDialog.gradeId = model.id
+                        editGradeDialog.gradeCode = model.code
+                        editGradeDialog.gradeSalary = model.baseSalary
+                        editGradeDialog.gradeDescription = model.description || ""
+                        editGradeDialog.open()
+                    }
+                }
 
-                            onClicked: {
-                                editGradeDialog.gradeId = modelData.id
-                                editGradeDialog.gradeCode = modelData.code
-                                editGradeDialog.gradeSalary = modelData.baseSalary
-                                editGradeDialog.gradeDescription = modelData.description || ""
-                                editGradeDialog.open()
-                            }
-                        }
+                Button {
+                    implicitWidth: 100
+                    implicitHeight: 36
 
-                        Button {
-                            implicitWidth: 100
-                            implicitHeight: 36
+                    background: Rectangle {
+                        color: parent.hovered ? "#3D1616" : "transparent"
+                        radius: 8
+                        border.width: 1
+                        border.color: colorScheme.error
+                    }
 
-                            background: Rectangle {
-                                color: parent.hovered ? "#3D1616" : "transparent"
-                                radius: 8
-                                border.width: 1
-                                border.color: colorScheme.error
-                            }
+                    contentItem: RowLayout {
+                        spacing: 6
 
-                            contentItem: RowLayout {
-                                spacing: 6
-
-                                MaterialIcon {
-                                    icon: "delete"
-                                    iconColor: colorScheme.error
-                                    size: 16
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-
-                                Text {
-                                    text: "Delete"
-                                    color: colorScheme.error
-                                    horizontalAlignment: Text.AlignHCenter
-                                    verticalAlignment: Text.AlignVCenter
-                                    font.pixelSize: 14
-                                    font.weight: Font.Medium
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-                            }
+                        MaterialIcon {
+                            icon: "delete"
+                            iconColor: colorScheme.error
+                            size: 16
+                            Layout.alignment: Qt.AlignVCenter
+                        }
 
-                            onClicked: {
-                                if (personnelApp) {
-                                    confirmDeleteDialog.gradeId = modelData.id
-                                    confirmDeleteDialog.gradeCode = modelData.code
-                                    confirmDeleteDialog.open()
-                                }
-                            }
+                        Text {
+                            text: "Delete"
+                            color: colorScheme.error
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            font.pixelSize: 14
+                            font.weight: Font.Medium
+                            Layout.alignment: Qt.AlignVCenter
+                        }
+                    }
+
+                    onClicked: {
+                        if (personnelApp) {
+                            confirmDeleteDialog.gradeId = model.id
+                            confirmDeleteDialog.gradeCode = model.code
+                            confirmDeleteDialog.open()
                         }
                     }
                 }
@@ -416,6 +415,11 @@ Flickable {
             editGradeDescField.text = gradeDescription
         }
 
+        onClosed: {
+            if (personnelApp)
+                personnelApp.salaryStatistics.clearWhatIf()
+        }
+
         Column {
             width: parent.width
             spacing: 20
@@ -490,6 +494,24 @@ Flickable {
                         placeholderText: "e.g., 70000"
                         colorScheme: root.colorScheme
                         width: parent.width
+
+                        // Previews the edit in the org-wide statistics before it is saved
+                        onTextChanged: {
+                            var salary = parseFloat(text)
+                            if (personnelApp && editGradeDialog.gradeId !== "" && !isNaN(salary))
+                                personnelApp.salaryStatistics.setWhatIfSalary(editGradeDialog.gradeId, salary)
+                        }
+                    }
+
+                    Text {
+                        property var stats: personnelApp ? personnelApp.salaryStatistics.organization : null
+
+                        visible: stats !== null && stats.count > 0
+                        width: parent.width
+                        wrapMode: Text.WordWrap
+                        text: stats ? "Org-wide salaries with this change: p10 $" + stats.p10.toFixed(0) + ", median $" + stats.p50.toFixed(0) + ", p90 $" + stats.p90.toFixed(0) : ""
+                        font.pixelSize: 12
+                        color: colorScheme.textOnSurfaceVariant
                     }
                 }
 
@@ -4,30 +4,120 @@
 
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QJsonParseError>
 #include <QNetworkRequest>
+#include <QPromise>
+#include <QtConcurrent>
 
 #ifdef DEBUG_API
 #include <QDebug>
 #endif
 
+namespace {
+
+// Runs on a pool thread. Gives up between elements once a newer response has replaced this one.
+// A payload that is not a JSON array gives no result at all.
+template <typename T>
+void decodeList(QPromise<QList<T>>& promise, const QByteArray& payload) {
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(payload, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isArray())
+        return;
+    QJsonArray array = doc.array();
+    QList<T> items;
+    items.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        if (promise.isCanceled())
+            return;
+        items.append(T::fromJson(value.toObject()));
+    }
+#ifdef DEBUG_API
+    qDebug() << "Decoded" << items.size() << "items";
+#endif
+    promise.addResult(std::move(items));
+}
+
+} // namespace
+
 ApiClient::ApiClient(QObject* parent)
-    : QObject(parent), m_networkManager(new QNetworkAccessManager(this)) {}
+    : QObject(parent), m_networkManager(new QNetworkAccessManager(this)),
+      m_scheduler(new RequestScheduler(m_networkManager, this)), m_refreshTimer(new QTimer(this)) {
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(RefreshDebounceMs);
+    connect(m_refreshTimer, &QTimer::timeout, this, &ApiClient::flushRefreshes);
+    trackForValidation();
+}
+
+void ApiClient::trackForValidation() {
+    // Connected before anyone else, so the indices are current by the time callers react.
+    // Employee lists are recorded where they are emitted, since only the stream knows
+    // whether a list includes the inactive employees.
+    connect(this, &ApiClient::departmentsReceived, this, [this](const QList<Department>& items) {
+        m_mutationValidator.setDepartments(items);
+    });
+    connect(this, &ApiClient::salaryGradesReceived, this, [this](const QList<SalaryGrade>& items) {
+        m_mutationValidator.setSalaryGrades(items);
+    });
+    connect(this, &ApiClient::departmentSaved, this, [this](const Department& department) {
+        m_mutationValidator.addDepartment(department.id);
+    });
+    connect(this, &ApiClient::departmentDeleted, this,
+            [this](const QString& id) { m_mutationValidator.removeDepartment(id); });
+    connect(this, &ApiClient::salaryGradeSaved, this, [this](const SalaryGrade& grade) {
+        m_mutationValidator.addSalaryGrade(grade.id);
+    });
+    connect(this, &ApiClient::salaryGradeDeleted, this,
+            [this](const QString& id) { m_mutationValidator.removeSalaryGrade(id); });
+    connect(this, &ApiClient::employeeSaved, this, [this](const Employee& employee) {
+        m_mutationValidator.upsertEmployee(employee);
+    });
+    connect(this, &ApiClient::employeeDeleted, this,
+            [this](const QString& id) { m_mutationValidator.removeEmployee(id); });
+}
+
+bool ApiClient::rejectLocally(const QString& id, const QJsonObject& fields) {
+    MutationValidator::Rejection rejection = m_mutationValidator.checkEmployee(id, fields);
+    if (!rejection.isRejected())
+        return false;
+#ifdef DEBUG_API
+    qDebug() << "Rejected locally:" << rejection.reason;
+#endif
+    ++m_avoidedRoundTrips;
+    emit requestStatsChanged();
+    // Reported from the event loop, like a server response would be
+    QTimer::singleShot(0, this, [this, reason = rejection.reason]() {
+        emit errorOccurred(reason);
+        emit operationCompleted(false, reason);
+    });
+    return true;
+}
 
 QString ApiClient::getBaseUrl() const {
-    return Config::instance().apiUrl();
+    return m_apiUrl.isEmpty() ? Config::instance().apiUrl() : m_apiUrl;
 }
 
-void ApiClient::getDepartments() {
+QString ApiClient::urlOf(Collection collection, const QString& id) const {
+    QString route;
+    switch (collection) {
+        case Departments:
+            route = Config::instance().routeDepartments();
+            break;
+        case Employees:
+            route = Config::instance().routeEmployees();
+            break;
+        case SalaryGrades:
+            route = Config::instance().routeSalaryGrades();
+            break;
+    }
+    return getBaseUrl() + route + (id.isEmpty() ? QString() : "/" + id);
+}
+
+void ApiClient::getDepartments(Priority priority) {
     QString url = getBaseUrl() + Config::instance().routeDepartments();
 #ifdef DEBUG_API
     qDebug() << "GET Departments:" << url;
 #endif
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QNetworkReply* reply = m_networkManager->get(request);
-    reply->setProperty("operation", "getDepartments");
-    connect(reply, &QNetworkReply::finished, this, &ApiClient::onReplyFinished);
+    sendGet(url, "getDepartments", Departments, priority);
 }
 
 void ApiClient::createDepartment(const QString& name, const QString& headId) {
@@ -37,7 +127,7 @@ void ApiClient::createDepartment(const QString& name, const QString& headId) {
         data["head_id"] = headId;
 
     QString url = getBaseUrl() + Config::instance().routeDepartments();
-    sendRequest("POST", url, data);
+    sendRequest("POST", url, Departments, QString(), data);
 }
 
 void ApiClient::updateDepartment(const QString& id, const QString& name, const QString& headId) {
@@ -48,28 +138,33 @@ void ApiClient::updateDepartment(const QString& id, const QString& name, const Q
         data["head_id"] = headId;
 
     QString url = getBaseUrl() + Config::instance().routeDepartments() + "/" + id;
-    sendRequest("PUT", url, data);
+    sendRequest("PUT", url, Departments, id, data);
 }
 
 void ApiClient::deleteDepartment(const QString& id) {
     QString url = getBaseUrl() + Config::instance().routeDepartments() + "/" + id;
-    sendRequest("DELETE", url);
+    sendRequest("DELETE", url, Departments, id);
 }
 
-void ApiClient::getEmployees(bool includeInactive) {
+void ApiClient::getEmployees(bool includeInactive, Priority priority) {
     QString url = getBaseUrl() + Config::instance().routeEmployees();
     if (includeInactive)
         url += "?include_inactive=true";
 #ifdef DEBUG_API
     qDebug() << "GET Employees:" << url;
 #endif
+    ScheduledRequest* call = sendGet(url, "getEmployees", Employees, priority);
+    if (!call)
+        return;
 
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QNetworkReply* reply = m_networkManager->get(request);
-    reply->setProperty("operation", "getEmployees");
-    connect(reply, &QNetworkReply::finished, this, &ApiClient::onReplyFinished);
+    // The employee list is the large one, so it is decoded as it arrives
+    int streamId = m_nextStreamId++;
+    call->setProperty("streamId", streamId);
+    EmployeeStream stream;
+    stream.includesInactive = includeInactive;
+    m_employeeStreams.insert(streamId, stream);
+    connect(call, &ScheduledRequest::readyRead, this,
+            [this, call, streamId]() { readEmployeeChunk(streamId, call->reply()->readAll()); });
 }
 
 void ApiClient::createEmployee(const QString& firstName, const QString& lastName,
@@ -87,32 +182,31 @@ void ApiClient::createEmployee(const QString& firstName, const QString& lastName
         data["manager_id"] = managerId;
     if (!gradeId.isEmpty())
         data["salary_grade_id"] = gradeId;
+    if (rejectLocally(QString(), data))
+        return;
 
     QString url = getBaseUrl() + Config::instance().routeEmployees();
-    sendRequest("POST", url, data);
+    sendRequest("POST", url, Employees, QString(), data);
 }
 
 void ApiClient::updateEmployee(const QString& id, const QJsonObject& updates) {
+    if (rejectLocally(id, updates))
+        return;
     QString url = getBaseUrl() + Config::instance().routeEmployees() + "/" + id;
-    sendRequest("PUT", url, updates);
+    sendRequest("PUT", url, Employees, id, updates);
 }
 
 void ApiClient::deleteEmployee(const QString& id) {
     QString url = getBaseUrl() + Config::instance().routeEmployees() + "/" + id;
-    sendRequest("DELETE", url);
+    sendRequest("DELETE", url, Employees, id);
 }
 
-void ApiClient::getSalaryGrades() {
+void ApiClient::getSalaryGrades(Priority priority) {
     QString url = getBaseUrl() + Config::instance().routeSalaryGrades();
 #ifdef DEBUG_API
     qDebug() << "GET Salary Grades:" << url;
 #endif
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QNetworkReply* reply = m_networkManager->get(request);
-    reply->setProperty("operation", "getSalaryGrades");
-    connect(reply, &QNetworkReply::finished, this, &ApiClient::onReplyFinished);
+    sendGet(url, "getSalaryGrades", SalaryGrades, priority);
 }
 
 void ApiClient::createSalaryGrade(const QString& code, double baseSalary,
@@ -124,7 +218,7 @@ void ApiClient::createSalaryGrade(const QString& code, double baseSalary,
         data["description"] = description;
 
     QString url = getBaseUrl() + Config::instance().routeSalaryGrades();
-    sendRequest("POST", url, data);
+    sendRequest("POST", url, SalaryGrades, QString(), data);
 }
 
 void ApiClient::updateSalaryGrade(const QString& id, const QString& code, double baseSalary,
@@ -138,15 +232,284 @@ void ApiClient::updateSalaryGrade(const QString& id, const QString& code, double
         data["description"] = description;
 
     QString url = getBaseUrl() + Config::instance().routeSalaryGrades() + "/" + id;
-    sendRequest("PUT", url, data);
+    sendRequest("PUT", url, SalaryGrades, id, data);
 }
 
 void ApiClient::deleteSalaryGrade(const QString& id) {
     QString url = getBaseUrl() + Config::instance().routeSalaryGrades() + "/" + id;
-    sendRequest("DELETE", url);
+    sendRequest("DELETE", url, SalaryGrades, id);
+}
+
+int ApiClient::submitBatch(const QList<Mutation>& mutations) {
+    int batchId = m_nextBatchId++;
+    Batch& batch = m_batches[batchId];
+    batch.queue = mutations;
+    for (const Mutation& mutation : mutations)
+        batch.collections.insert(mutation.collection);
+#ifdef DEBUG_API
+    qDebug() << "Batch" << batchId << "with" << mutations.size() << "mutations";
+#endif
+    // Started from the event loop so the result never arrives before the caller has the id
+    QTimer::singleShot(0, this, [this, batchId]() { sendBatchSteps(batchId); });
+    return batchId;
 }
 
-void ApiClient::sendRequest(const QString& method, const QString& url, const QJsonObject& data) {
+int ApiClient::sendMutation(const Mutation& mutation, Priority priority) {
+    int requestId = m_nextRequestId++;
+    ScheduledRequest* call = sendRequest(mutation.method, urlOf(mutation.collection, mutation.id),
+                                         mutation.collection, mutation.id, mutation.data, priority);
+    if (!call) {
+        QString error = "Unsupported method " + mutation.method;
+        QTimer::singleShot(0, this, [this, requestId, error]() {
+            emit mutationFinished(requestId, false, QJsonObject(), error);
+        });
+        return requestId;
+    }
+    call->setProperty("requestId", requestId);
+    return requestId;
+}
+
+void ApiClient::sendBatchSteps(int batchId) {
+    auto batch = m_batches.find(batchId);
+    if (batch == m_batches.end())
+        return;
+
+    // Forward steps stop at the first failure, compensations are all attempted
+    bool sending = batch->rollingBack || batch->error.isEmpty();
+    while (sending && batch->sent.size() < BatchConcurrency && !batch->queue.isEmpty()) {
+        Mutation mutation = batch->queue.takeFirst();
+        ScheduledRequest* call =
+            sendRequest(mutation.method, urlOf(mutation.collection, mutation.id),
+                        mutation.collection, mutation.id, mutation.data);
+        if (!call) {
+            if (!batch->rollingBack)
+                batch->error = "Unsupported method " + mutation.method;
+            sending = batch->rollingBack;
+            continue;
+        }
+        call->setProperty("batchId", batchId);
+        batch->sent.insert(call, mutation);
+    }
+    if (!batch->sent.isEmpty())
+        return;
+
+    if (!batch->error.isEmpty() && !batch->rollingBack && !batch->compensations.isEmpty()) {
+#ifdef DEBUG_API
+        qDebug() << "Rolling back batch" << batchId << "after:" << batch->error;
+#endif
+        batch->rollingBack = true;
+        batch->queue.clear();
+        for (auto it = batch->compensations.crbegin(); it != batch->compensations.crend(); ++it)
+            batch->queue.append(*it);
+        sendBatchSteps(batchId);
+        return;
+    }
+
+    Batch done = m_batches.take(batchId);
+    bool success = done.error.isEmpty();
+    QString message = "Operation completed successfully";
+    if (!success) {
+        message = done.error;
+        if (done.rollingBack && done.rollbackFailures > 0)
+            message += " (rollback incomplete)";
+        else if (done.rollingBack)
+            message += " (changes rolled back)";
+
+        // The models saw every step and compensation go by; one fetch settles what's left
+        for (Collection collection : std::as_const(done.collections))
+            requestRefresh(collection);
+        emit errorOccurred(message);
+    }
+    emit batchFinished(batchId, success, message);
+    emit operationCompleted(success, message);
+}
+
+void ApiClient::onBatchReply(int batchId, ScheduledRequest* call, const QJsonDocument& doc) {
+    auto batch = m_batches.find(batchId);
+    if (batch == m_batches.end())
+        return;
+
+    Mutation mutation = batch->sent.take(call);
+    QNetworkReply* reply = call->reply();
+    if (reply->error() != QNetworkReply::NoError) {
+        if (batch->rollingBack)
+            ++batch->rollbackFailures;
+        else if (batch->error.isEmpty())
+            batch->error = reply->errorString();
+    } else if (!batch->rollingBack) {
+        if (mutation.method == "POST") {
+            QString createdId = doc.object().value("id").toString();
+            if (!createdId.isEmpty())
+                batch->compensations.append({"DELETE", mutation.collection, createdId, {}, {}});
+        } else if (mutation.method == "PUT" && !mutation.undoData.isEmpty()) {
+            batch->compensations.append(
+                {"PUT", mutation.collection, mutation.id, mutation.undoData, {}});
+        }
+    }
+    sendBatchSteps(batchId);
+}
+
+void ApiClient::requestRefresh(Collection collection) {
+    if (m_pendingRefreshes.contains(collection)) {
+        ++m_mergedRefreshes;
+        emit requestStatsChanged();
+    }
+    m_pendingRefreshes.insert(collection);
+    m_refreshTimer->start();
+}
+
+void ApiClient::flushRefreshes() {
+    // Still inside a burst; the last mutation to finish restarts the timer
+    if (m_mutationsInFlight > 0)
+        return;
+
+    QSet<Collection> pending;
+    pending.swap(m_pendingRefreshes);
+    if (pending.contains(Departments))
+        getDepartments(RequestScheduler::Background);
+    if (pending.contains(Employees))
+        getEmployees(false, RequestScheduler::Background);
+    if (pending.contains(SalaryGrades))
+        getSalaryGrades(RequestScheduler::Background);
+}
+
+void ApiClient::prioritize(Collection collection) {
+    for (ScheduledRequest* call : std::as_const(m_inFlightGets)) {
+        if (call->property("collection").toInt() == collection)
+            m_scheduler->promote(call, RequestScheduler::Interactive);
+    }
+}
+
+ScheduledRequest* ApiClient::sendGet(const QString& url, const QString& operation,
+                                     Collection collection, Priority priority) {
+    // Whoever asked second gets the same result through the same signal, and no later than
+    // its own priority would have
+    if (ScheduledRequest* shared = m_inFlightGets.value(url)) {
+#ifdef DEBUG_API
+        qDebug() << "Sharing in-flight request:" << url;
+#endif
+        m_scheduler->promote(shared, priority);
+        ++m_coalescedRequests;
+        emit requestStatsChanged();
+        return nullptr;
+    }
+
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    // Only revalidate what the models actually hold, not a list fetched with other parameters
+    auto validators = m_validators.constFind(collection);
+    if (validators != m_validators.cend() && validators->url == url) {
+        if (!validators->etag.isEmpty())
+            request.setRawHeader("If-None-Match", validators->etag);
+        if (!validators->lastModified.isEmpty())
+            request.setRawHeader("If-Modified-Since", validators->lastModified);
+    }
+
+    ScheduledRequest* call = m_scheduler->submit(request, "GET", priority);
+    call->setProperty("operation", operation);
+    call->setProperty("collection", static_cast<int>(collection));
+    call->setProperty("requestUrl", url);
+    m_inFlightGets.insert(url, call);
+    connect(call, &ScheduledRequest::finished, this, &ApiClient::onReplyFinished);
+    return call;
+}
+
+void ApiClient::readEmployeeChunk(int streamId, const QByteArray& chunk) {
+    auto stream = m_employeeStreams.find(streamId);
+    if (stream == m_employeeStreams.end())
+        return;
+
+    stream->reader.addData(chunk);
+    QList<QByteArray> elements;
+    QByteArray element;
+    while (stream->reader.readNextBytes(element))
+        elements.append(element);
+    if (elements.isEmpty())
+        return;
+
+    auto* watcher = new QFutureWatcher<DecodedEmployees>(this);
+    stream->decodes.append(watcher);
+    connect(watcher, &QFutureWatcherBase::finished, this,
+            [this, streamId]() { deliverEmployeeBatches(streamId); });
+    watcher->setFuture(QtConcurrent::run(&ApiClient::decodeEmployees, elements));
+}
+
+ApiClient::DecodedEmployees ApiClient::decodeEmployees(const QList<QByteArray>& elements) {
+    DecodedEmployees decoded;
+    decoded.employees.reserve(elements.size());
+    for (const QByteArray& element : elements) {
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(element, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            decoded.error = parseError.errorString();
+            break;
+        }
+        // Non-object elements carry nothing we could decode
+        if (doc.isObject())
+            decoded.employees.append(Employee::fromJson(doc.object()));
+    }
+    return decoded;
+}
+
+void ApiClient::deliverEmployeeBatches(int streamId) {
+    // Listeners may react to a batch by starting requests, so the stream is looked up anew
+    // after every emit
+    while (true) {
+        auto stream = m_employeeStreams.find(streamId);
+        if (stream == m_employeeStreams.end())
+            return;
+
+        if (!stream->decodes.isEmpty()) {
+            // A batch that finished early waits for the ones framed before it
+            QFutureWatcher<DecodedEmployees>* watcher = stream->decodes.first();
+            if (!watcher->isFinished())
+                return;
+            stream->decodes.removeFirst();
+            watcher->deleteLater();
+
+            DecodedEmployees decoded = watcher->result();
+            if (stream->error.isEmpty())
+                stream->error = decoded.error;
+            // Nothing after a broken element is handed out
+            if (!stream->error.isEmpty() || decoded.employees.isEmpty())
+                continue;
+            stream->employees.append(decoded.employees);
+            emit employeesBatchReceived(decoded.employees);
+            continue;
+        }
+
+        if (!stream->complete)
+            return;
+        EmployeeStream finished = m_employeeStreams.take(streamId);
+        if (finished.error.isEmpty())
+            finished.error = finished.reader.errorString();
+        if (!finished.error.isEmpty() || !finished.reader.atEnd()) {
+            // The model did not take this list, so it must not be revalidated against it
+            m_validators.remove(Employees);
+            emit errorOccurred("Malformed employee list: " + finished.error);
+        } else {
+#ifdef DEBUG_API
+            qDebug() << "Received" << finished.employees.size() << "employees";
+#endif
+            m_mutationValidator.setEmployees(finished.employees, finished.includesInactive);
+            emit employeesReceived(finished.employees);
+        }
+        return;
+    }
+}
+
+void ApiClient::dropEmployeeStream(int streamId) {
+    EmployeeStream stream = m_employeeStreams.take(streamId);
+    for (QFutureWatcher<DecodedEmployees>* watcher : stream.decodes) {
+        watcher->cancel();
+        watcher->deleteLater();
+    }
+}
+
+ScheduledRequest* ApiClient::sendRequest(const QString& method, const QString& url,
+                                         Collection collection, const QString& id,
+                                         const QJsonObject& data, Priority priority) {
 #ifdef DEBUG_API
     qDebug() << method << "request to:" << url;
     if (!data.isEmpty()) {
@@ -157,83 +520,189 @@ void ApiClient::sendRequest(const QString& method, const QString& url, const QJs
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
-    QNetworkReply* reply = nullptr;
-    if (method == "POST") {
-        reply = m_networkManager->post(request, QJsonDocument(data).toJson());
-    } else if (method == "PUT") {
-        reply = m_networkManager->put(request, QJsonDocument(data).toJson());
-    } else if (method == "DELETE") {
-        reply = m_networkManager->deleteResource(request);
-    }
-
-    if (reply) {
-        reply->setProperty("operation", method.toLower());
-        connect(reply, &QNetworkReply::finished, this, &ApiClient::onReplyFinished);
+    ScheduledRequest* call = nullptr;
+    if (method == "POST" || method == "PUT")
+        call = m_scheduler->submit(request, method.toLatin1(), priority,
+                                   QJsonDocument(data).toJson());
+    else if (method == "DELETE")
+        call = m_scheduler->submit(request, "DELETE", priority);
+
+    if (call) {
+        ++m_mutationsInFlight;
+        call->setProperty("operation", method.toLower());
+        call->setProperty("collection", static_cast<int>(collection));
+        call->setProperty("entityId", id);
+        connect(call, &ScheduledRequest::finished, this, &ApiClient::onReplyFinished);
     }
+    return call;
 }
 
 void ApiClient::onReplyFinished() {
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply)
+    auto* call = qobject_cast<ScheduledRequest*>(sender());
+    if (!call)
         return;
+    QNetworkReply* reply = call->reply();
 
-    QString operation = reply->property("operation").toString();
+    QString operation = call->property("operation").toString();
 #ifdef DEBUG_API
     qDebug() << "Response received for operation:" << operation;
 #endif
 
+    if (operation.startsWith("get")) {
+        m_inFlightGets.remove(call->property("requestUrl").toString());
+    } else if (--m_mutationsInFlight == 0 && !m_pendingRefreshes.isEmpty()) {
+        m_refreshTimer->start();
+    }
+
+    // Steps of a batch report through the batch once it is done, and mutations sent with
+    // sendMutation() only through mutationFinished()
+    int batchId = call->property("batchId").toInt();
+    int requestId = call->property("requestId").toInt();
+
     if (reply->error() != QNetworkReply::NoError) {
 #ifdef DEBUG_API
         qDebug() << "Error:" << reply->errorString();
 #endif
-        emit errorOccurred(reply->errorString());
-        emit operationCompleted(false, reply->errorString());
-        reply->deleteLater();
+        dropEmployeeStream(call->property("streamId").toInt());
+        if (batchId != 0) {
+            onBatchReply(batchId, call, QJsonDocument());
+        } else if (requestId != 0) {
+            emit mutationFinished(requestId, false, QJsonObject(), reply->errorString());
+        } else {
+            emit errorOccurred(reply->errorString());
+            emit operationCompleted(false, reply->errorString());
+        }
+        call->deleteLater();
         return;
     }
 
+    if (operation.startsWith("get")) {
+        auto collection = static_cast<Collection>(call->property("collection").toInt());
+        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+#ifdef DEBUG_API
+            qDebug() << "Not modified:" << operation;
+#endif
+            ++m_cacheHits;
+            emit requestStatsChanged();
+            dropEmployeeStream(call->property("streamId").toInt());
+            emit notModified(collection);
+            call->deleteLater();
+            return;
+        }
+
+        ++m_cacheMisses;
+        emit requestStatsChanged();
+        Validators validators;
+        validators.url = call->property("requestUrl").toString();
+        validators.etag = reply->rawHeader("ETag");
+        validators.lastModified = reply->rawHeader("Last-Modified");
+        if (validators.etag.isEmpty() && validators.lastModified.isEmpty())
+            m_validators.remove(collection);
+        else
+            m_validators.insert(collection, validators);
+    }
+
     QByteArray responseData = reply->readAll();
 #ifdef DEBUG_API
     qDebug() << "Response data:" << responseData.left(200);
 #endif
-    QJsonDocument doc = QJsonDocument::fromJson(responseData);
 
     if (operation == "getDepartments") {
-        QList<Department> departments;
-        QJsonArray array = doc.array();
-#ifdef DEBUG_API
-        qDebug() << "Received" << array.size() << "departments";
-#endif
-        for (const QJsonValue& value : array) {
-            departments.append(Department::fromJson(value.toObject()));
-        }
-        emit departmentsReceived(departments);
+        decodeInBackground(operation, Departments, responseData,
+                           &ApiClient::departmentsReceived);
     } else if (operation == "getEmployees") {
-        QList<Employee> employees;
-        QJsonArray array = doc.array();
-#ifdef DEBUG_API
-        qDebug() << "Received" << array.size() << "employees";
-#endif
-        for (const QJsonValue& value : array) {
-            employees.append(Employee::fromJson(value.toObject()));
+        int streamId = call->property("streamId").toInt();
+        readEmployeeChunk(streamId, responseData);
+        auto stream = m_employeeStreams.find(streamId);
+        if (stream != m_employeeStreams.end()) {
+            // The full list goes out once the batches still decoding have been handed out
+            stream->complete = true;
+            deliverEmployeeBatches(streamId);
         }
-        emit employeesReceived(employees);
     } else if (operation == "getSalaryGrades") {
-        QList<SalaryGrade> grades;
-        QJsonArray array = doc.array();
-#ifdef DEBUG_API
-        qDebug() << "Received" << array.size() << "salary grades";
-#endif
-        for (const QJsonValue& value : array) {
-            grades.append(SalaryGrade::fromJson(value.toObject()));
-        }
-        emit salaryGradesReceived(grades);
+        decodeInBackground(operation, SalaryGrades, responseData,
+                           &ApiClient::salaryGradesReceived);
     } else {
 #ifdef DEBUG_API
         qDebug() << "Operation completed successfully:" << operation;
 #endif
-        emit operationCompleted(true, "Operation completed successfully");
+        // Mutation responses hold a single entity, cheap enough to decode right here
+        QJsonDocument doc = QJsonDocument::fromJson(responseData);
+        auto collection = static_cast<Collection>(call->property("collection").toInt());
+        if (!applyMutation(operation, collection, call->property("entityId").toString(), doc))
+            emit resyncRequired(collection);
+        if (batchId != 0)
+            onBatchReply(batchId, call, doc);
+        else if (requestId != 0)
+            emit mutationFinished(requestId, true, doc.object(), QString());
+        else
+            emit operationCompleted(true, "Operation completed successfully");
+    }
+
+    call->deleteLater();
+}
+
+template <typename T>
+void ApiClient::decodeInBackground(const QString& operation, Collection collection,
+                                   const QByteArray& payload,
+                                   void (ApiClient::*received)(QList<T>)) {
+    if (QFutureWatcherBase* stale = m_decodes.take(operation)) {
+        stale->cancel();
+        stale->deleteLater();
+    }
+
+    auto* watcher = new QFutureWatcher<QList<T>>(this);
+    m_decodes.insert(operation, watcher);
+    connect(watcher, &QFutureWatcherBase::finished, this,
+            [this, watcher, operation, collection, received]() {
+                watcher->deleteLater();
+                if (m_decodes.value(operation) != watcher || watcher->isCanceled())
+                    return;
+                m_decodes.remove(operation);
+                if (watcher->future().resultCount() > 0) {
+                    emit(this->*received)(watcher->result());
+                } else {
+                    // Nothing was delivered, so the next fetch must not revalidate to a 304
+                    m_validators.remove(collection);
+                    emit errorOccurred("Malformed response to " + operation);
+                }
+            });
+    watcher->setFuture(QtConcurrent::run(&decodeList<T>, payload));
+}
+
+bool ApiClient::applyMutation(const QString& operation, Collection collection, const QString& id,
+                              const QJsonDocument& doc) {
+    if (operation == "delete") {
+        if (id.isEmpty())
+            return false;
+        switch (collection) {
+            case Departments:
+                emit departmentDeleted(id);
+                break;
+            case Employees:
+                emit employeeDeleted(id);
+                break;
+            case SalaryGrades:
+                emit salaryGradeDeleted(id);
+                break;
+        }
+        return true;
     }
 
-    reply->deleteLater();
+    // Create and update answer with the stored entity; without one there is nothing to apply
+    QJsonObject json = doc.object();
+    if (!json.contains("id") || json["id"].toString().isEmpty())
+        return false;
+    switch (collection) {
+        case Departments:
+            emit departmentSaved(Department::fromJson(json));
+            break;
+        case Employees:
+            emit employeeSaved(Employee::fromJson(json));
+            break;
+        case SalaryGrades:
+            emit salaryGradeSaved(SalaryGrade::fromJson(json));
+            break;
+    }
+    return true;
 }
@@ -0,0 +1,447 @@
+#include "api/employeeimporter.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QJsonValue>
+#include <QRegularExpression>
+
+#ifdef DEBUG_API
+#include <QDebug>
+#endif
+
+namespace {
+
+const QStringList Roles = {"Admin", "DepartmentHead", "DeputyHead", "Employee"};
+
+// First non-empty value among `keys`, as text. JSON rows may carry numbers or booleans
+// where CSV rows always have strings.
+QString fieldOf(const QJsonObject& row, const QStringList& keys) {
+    for (const QString& key : keys) {
+        QJsonValue value = row.value(key);
+        QString text;
+        if (value.isString())
+            text = value.toString().trimmed();
+        else if (value.isDouble())
+            text = QString::number(value.toDouble());
+        else if (value.isBool())
+            text = value.toBool() ? "true" : "false";
+        if (!text.isEmpty())
+            return text;
+    }
+    return QString();
+}
+
+} // namespace
+
+double EmployeeImporter::Summary::rowsPerSecond() const {
+    return elapsedMs > 0 ? (imported + failed) * 1000.0 / elapsedMs : 0.0;
+}
+
+EmployeeImporter::EmployeeImporter(ApiClient* client, QObject* parent)
+    : QObject(parent), m_client(client) {
+    connect(m_client, &ApiClient::mutationFinished, this, &EmployeeImporter::onMutationFinished);
+}
+
+QString EmployeeImporter::journalPathFor(const QString& path) {
+    return path + ".import-journal";
+}
+
+bool EmployeeImporter::start(const QString& path, const Options& options) {
+    if (m_running)
+        return false;
+
+    m_options = options;
+    m_options.window = qMax(1, options.window);
+    m_path = path;
+    m_fatalError.clear();
+    m_summary = Summary();
+    m_errors.clear();
+    m_inFlight.clear();
+    m_journaledRows.clear();
+    m_departmentIds.clear();
+    m_gradeIds.clear();
+    m_existingEmails.clear();
+    m_claimedEmails.clear();
+    m_columns.clear();
+    m_csv.reset();
+    m_json = JsonArrayReader();
+    m_inputDone = false;
+    m_nextRow = 1;
+    m_lastProgressMs = -1;
+
+    m_input.close();
+    m_input.setFileName(path);
+    if (!m_input.open(QIODevice::ReadOnly)) {
+        m_fatalError = "Cannot open " + path + ": " + m_input.errorString();
+        return false;
+    }
+
+    m_format = path.endsWith(".json", Qt::CaseInsensitive) ? Format::Json : Format::Csv;
+    if (m_format == Format::Csv) {
+        m_csv = std::make_unique<QTextStream>(&m_input);
+        QString header;
+        while (header.trimmed().isEmpty() && !m_csv->atEnd())
+            header = m_csv->readLine();
+        if (header.startsWith(QChar(0xFEFF)))
+            header.remove(0, 1);
+        if (header.trimmed().isEmpty()) {
+            m_fatalError = path + " has no header row";
+            m_input.close();
+            return false;
+        }
+        for (const QString& column : splitCsvLine(header))
+            m_columns.append(column.trimmed().toLower());
+    }
+
+    if (!openJournal()) {
+        m_input.close();
+        return false;
+    }
+
+    m_running = true;
+    m_clock.start();
+    fetchLookups();
+    return true;
+}
+
+bool EmployeeImporter::openJournal() {
+    m_journal.close();
+    m_journal.setFileName(journalPathFor(m_path));
+
+    // Rows are matched by position, so fixing a failed row in place and resuming is fine;
+    // rows imported under a different position are still caught by their email
+    if (m_options.resume && m_journal.exists()) {
+        if (!m_journal.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            m_fatalError = "Cannot read " + m_journal.fileName() + ": " + m_journal.errorString();
+            return false;
+        }
+        while (!m_journal.atEnd()) {
+            bool ok = false;
+            int row = m_journal.readLine().trimmed().toInt(&ok);
+            if (ok)
+                m_journaledRows.insert(row);
+        }
+        m_journal.close();
+    }
+
+    QIODevice::OpenMode mode = QIODevice::WriteOnly | QIODevice::Text;
+    mode |= m_options.resume ? QIODevice::Append : QIODevice::Truncate;
+    if (m_journal.open(mode))
+        return true;
+    m_fatalError = "Cannot write " + m_journal.fileName() + ": " + m_journal.errorString();
+    return false;
+}
+
+void EmployeeImporter::fetchLookups() {
+    auto onDepartments = [this](const QList<Department>& departments) {
+        for (const Department& department : departments) {
+            m_departmentIds.insert(department.name.toLower(), department.id);
+            m_departmentIds.insert(department.id.toLower(), department.id);
+        }
+        lookupReceived();
+    };
+    auto onGrades = [this](const QList<SalaryGrade>& grades) {
+        for (const SalaryGrade& grade : grades) {
+            m_gradeIds.insert(grade.code.toLower(), grade.id);
+            m_gradeIds.insert(grade.id.toLower(), grade.id);
+        }
+        lookupReceived();
+    };
+    auto onEmployees = [this](const QList<Employee>& employees) {
+        for (const Employee& employee : employees)
+            m_existingEmails.insert(employee.email.toLower());
+        lookupReceived();
+    };
+
+    m_pendingLookups = 3;
+    m_lookupConnections.append(
+        connect(m_client, &ApiClient::departmentsReceived, this, onDepartments));
+    m_lookupConnections.append(connect(m_client, &ApiClient::salaryGradesReceived, this, onGrades));
+    m_lookupConnections.append(connect(m_client, &ApiClient::employeesReceived, this, onEmployees));
+    m_lookupConnections.append(
+        connect(m_client, &ApiClient::notModified, this, [this](ApiClient::Collection) {
+            stop("The API client only has cached lookups; use a fresh client");
+            finish();
+        }));
+    m_lookupConnections.append(
+        connect(m_client, &ApiClient::errorOccurred, this, [this](const QString& error) {
+            stop("Could not load departments, grades and employees: " + error);
+            finish();
+        }));
+
+    m_client->getDepartments(RequestScheduler::Bulk);
+    m_client->getSalaryGrades(RequestScheduler::Bulk);
+    // Inactive employees keep their email, so they count for duplicates too
+    m_client->getEmployees(true, RequestScheduler::Bulk);
+}
+
+void EmployeeImporter::lookupReceived() {
+    if (--m_pendingLookups > 0)
+        return;
+    dropLookupConnections();
+#ifdef DEBUG_API
+    qDebug() << "Import lookups:" << m_departmentIds.size() / 2 << "departments,"
+             << m_gradeIds.size() / 2 << "grades," << m_existingEmails.size() << "emails";
+#endif
+    // Throughput covers the rows, not the lookups
+    m_clock.restart();
+    pump();
+}
+
+void EmployeeImporter::dropLookupConnections() {
+    for (const QMetaObject::Connection& connection : m_lookupConnections)
+        disconnect(connection);
+    m_lookupConnections.clear();
+}
+
+void EmployeeImporter::pump() {
+    while (m_fatalError.isEmpty() && !m_inputDone && m_inFlight.size() < m_options.window) {
+        QJsonObject row;
+        QString error;
+        if (!readRow(row, error)) {
+            m_inputDone = true;
+            break;
+        }
+
+        int rowNumber = m_nextRow++;
+        if (m_journaledRows.contains(rowNumber)) {
+            ++m_summary.skipped;
+            continue;
+        }
+
+        QJsonObject payload;
+        if (error.isEmpty())
+            error = validate(row, payload);
+        if (!error.isEmpty()) {
+            recordFailure(rowNumber, error);
+            continue;
+        }
+
+        QString email = payload.value("email").toString().toLower();
+        if (m_existingEmails.contains(email)) {
+            // Sent by the interrupted run, which stopped before journaling the reply
+            if (m_options.resume) {
+                ++m_summary.skipped;
+                continue;
+            }
+            recordFailure(rowNumber, "An employee with email " + email + " already exists");
+            continue;
+        }
+        if (m_claimedEmails.contains(email)) {
+            recordFailure(rowNumber, "Email " + email + " appears more than once in the input");
+            continue;
+        }
+
+        m_claimedEmails.insert(email);
+        int requestId = m_client->sendMutation({"POST", ApiClient::Employees, QString(), payload},
+                                               RequestScheduler::Bulk);
+        m_inFlight.insert(requestId, {rowNumber, email});
+    }
+
+    reportProgress(false);
+    if (m_inFlight.isEmpty() && (m_inputDone || !m_fatalError.isEmpty()))
+        finish();
+}
+
+bool EmployeeImporter::readRow(QJsonObject& row, QString& error) {
+    if (m_format == Format::Csv)
+        return readCsvRow(row, error);
+    return readJsonRow(row);
+}
+
+bool EmployeeImporter::readCsvRow(QJsonObject& row, QString& error) {
+    // A quoted field may span lines, so a record ends at the first line break outside quotes
+    QString record;
+    bool quoteOpen = false;
+    do {
+        if (m_csv->atEnd()) {
+            if (quoteOpen)
+                stop(m_path + " ends inside a quoted field");
+            return false;
+        }
+        QString line = m_csv->readLine();
+        if (!quoteOpen && line.trimmed().isEmpty())
+            continue;
+        record += quoteOpen ? "\n" + line : line;
+        quoteOpen = record.count('"') % 2 != 0;
+    } while (quoteOpen || record.isEmpty());
+
+    QStringList fields = splitCsvLine(record);
+    if (fields.size() != m_columns.size()) {
+        error = QString("Expected %1 fields, found %2").arg(m_columns.size()).arg(fields.size());
+        return true;
+    }
+    for (int i = 0; i < fields.size(); ++i)
+        row.insert(m_columns.at(i), fields.at(i));
+    return true;
+}
+
+bool EmployeeImporter::readJsonRow(QJsonObject& row) {
+    while (!m_json.readNext(row)) {
+        if (m_json.hasError()) {
+            stop("Malformed JSON in " + m_path + ": " + m_json.errorString());
+            return false;
+        }
+        if (m_json.atEnd())
+            return false;
+        if (m_input.atEnd()) {
+            stop(m_path + " ends before its JSON array is closed");
+            return false;
+        }
+        m_json.addData(m_input.read(ReadChunkSize));
+    }
+    return true;
+}
+
+QStringList EmployeeImporter::splitCsvLine(const QString& line) {
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+    for (int i = 0; i < line.size(); ++i) {
+        QChar c = line.at(i);
+        if (quoted) {
+            if (c != '"') {
+                field += c;
+            } else if (i + 1 < line.size() && line.at(i + 1) == '"') {
+                field += c;
+                ++i;
+            } else {
+                quoted = false;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.append(field);
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    fields.append(field);
+    return fields;
+}
+
+QString EmployeeImporter::validate(const QJsonObject& row, QJsonObject& payload) const {
+    static const QRegularExpression emailPattern("^[^@\\s]+@[^@\\s]+\\.[^@\\s]+$");
+
+    QString firstName = fieldOf(row, {"first_name"});
+    QString lastName = fieldOf(row, {"last_name"});
+    if (firstName.isEmpty() || lastName.isEmpty())
+        return "first_name and last_name are required";
+    payload["first_name"] = firstName;
+    payload["last_name"] = lastName;
+
+    QString email = fieldOf(row, {"email"});
+    if (!emailPattern.match(email).hasMatch())
+        return "Invalid email \"" + email + "\"";
+    payload["email"] = email;
+
+    QString role = fieldOf(row, {"role"});
+    if (!role.isEmpty()) {
+        if (!Roles.contains(role))
+            return "Unknown role \"" + role + "\"";
+        payload["role"] = role;
+    }
+
+    QString department = fieldOf(row, {"department_id", "department"});
+    if (!department.isEmpty()) {
+        QString departmentId = m_departmentIds.value(department.toLower());
+        if (departmentId.isEmpty())
+            return "Unknown department \"" + department + "\"";
+        payload["department_id"] = departmentId;
+    }
+
+    QString grade = fieldOf(row, {"salary_grade_id", "salary_grade"});
+    if (!grade.isEmpty()) {
+        QString gradeId = m_gradeIds.value(grade.toLower());
+        if (gradeId.isEmpty())
+            return "Unknown salary grade \"" + grade + "\"";
+        payload["salary_grade_id"] = gradeId;
+    }
+
+    QString hireDate = fieldOf(row, {"hire_date"});
+    if (!hireDate.isEmpty()) {
+        if (!QDate::fromString(hireDate, Qt::ISODate).isValid() &&
+            !QDateTime::fromString(hireDate, Qt::ISODate).isValid())
+            return "Invalid hire_date \"" + hireDate + "\"";
+        payload["hire_date"] = hireDate;
+    }
+
+    QString active = fieldOf(row, {"active"}).toLower();
+    if (active == "true" || active == "1" || active == "yes")
+        payload["active"] = true;
+    else if (active == "false" || active == "0" || active == "no")
+        payload["active"] = false;
+    else if (!active.isEmpty())
+        return "Invalid active flag \"" + active + "\"";
+
+    return QString();
+}
+
+void EmployeeImporter::onMutationFinished(int requestId, bool success, const QJsonObject& entity,
+                                          const QString& error) {
+    Q_UNUSED(entity);
+    auto pending = m_inFlight.find(requestId);
+    if (pending == m_inFlight.end())
+        return;
+    PendingRow row = pending.value();
+    m_inFlight.erase(pending);
+
+    if (success) {
+        ++m_summary.imported;
+        // Flushed per row so an interruption loses at most the replies still in flight
+        m_journal.write(QByteArray::number(row.row) + "\n");
+        m_journal.flush();
+    } else {
+        m_claimedEmails.remove(row.email);
+        recordFailure(row.row, error);
+    }
+    pump();
+}
+
+void EmployeeImporter::recordFailure(int row, const QString& reason) {
+    ++m_summary.failed;
+    m_errors.append({row, reason});
+    emit rowFailed(row, reason);
+}
+
+void EmployeeImporter::reportProgress(bool force) {
+    qint64 now = m_clock.elapsed();
+    if (!force && m_lastProgressMs >= 0 && now - m_lastProgressMs < ProgressIntervalMs)
+        return;
+    m_lastProgressMs = now;
+    m_summary.elapsedMs = now;
+    emit progress(m_summary.imported + m_summary.failed + m_summary.skipped,
+                  m_summary.rowsPerSecond());
+}
+
+void EmployeeImporter::stop(const QString& error) {
+    if (m_fatalError.isEmpty())
+        m_fatalError = error;
+}
+
+void EmployeeImporter::finish() {
+    if (!m_running)
+        return;
+    m_running = false;
+    dropLookupConnections();
+    reportProgress(true);
+    m_csv.reset();
+    m_input.close();
+
+#ifdef DEBUG_API
+    qDebug() << "Import finished:" << m_summary.imported << "imported," << m_summary.failed
+             << "failed," << m_summary.skipped << "skipped";
+#endif
+    if (!m_fatalError.isEmpty()) {
+        m_journal.close();
+        emit failed(m_fatalError);
+        return;
+    }
+    // Kept while rows failed, so a corrected file can be resumed without duplicates
+    if (m_summary.failed == 0)
+        m_journal.remove();
+    else
+        m_journal.close();
+    emit finished();
+}
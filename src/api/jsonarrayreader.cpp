@@ -0,0 +1,110 @@
+#include "api/jsonarrayreader.h"
+
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+namespace {
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+} // namespace
+
+void JsonArrayReader::addData(const QByteArray& data) {
+    if (!hasError())
+        m_buffer.append(data);
+}
+
+bool JsonArrayReader::readNext(QJsonObject& element) {
+    QByteArray bytes;
+    while (readNextBytes(bytes)) {
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(bytes, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            fail(parseError.errorString());
+            return false;
+        }
+        // Non-object elements carry nothing we could decode
+        if (doc.isObject()) {
+            element = doc.object();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JsonArrayReader::readNextBytes(QByteArray& element) {
+    while (!hasError() && m_pos < m_buffer.size()) {
+        const char c = m_buffer.at(m_pos);
+
+        if (m_inString) {
+            if (m_escaped)
+                m_escaped = false;
+            else if (c == '\\')
+                m_escaped = true;
+            else if (c == '"')
+                m_inString = false;
+            ++m_pos;
+            continue;
+        }
+
+        if (m_depth == 0) {
+            // Outside the array only whitespace and the opening bracket are allowed
+            if (c == '[' && !m_started) {
+                m_started = true;
+                m_depth = 1;
+            } else if (!isWhitespace(c)) {
+                fail(QStringLiteral("Expected a JSON array"));
+                return false;
+            }
+            ++m_pos;
+            continue;
+        }
+
+        switch (c) {
+            case '"':
+                m_inString = true;
+                break;
+            case '{':
+            case '[':
+                if (m_depth == 1)
+                    m_elementStart = m_pos;
+                ++m_depth;
+                break;
+            case '}':
+            case ']':
+                --m_depth;
+                if (m_depth == 0) {
+                    m_finished = true;
+                } else if (m_depth == 1 && m_elementStart >= 0) {
+                    element = m_buffer.mid(m_elementStart, m_pos - m_elementStart + 1);
+                    m_buffer.remove(0, m_pos + 1);
+                    m_pos = 0;
+                    m_elementStart = -1;
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+        ++m_pos;
+    }
+
+    // Everything scanned; keep only the element that is still incomplete
+    if (m_elementStart < 0) {
+        m_buffer.clear();
+        m_pos = 0;
+    } else if (m_elementStart > 0) {
+        m_buffer.remove(0, m_elementStart);
+        m_pos -= m_elementStart;
+        m_elementStart = 0;
+    }
+    return false;
+}
+
+void JsonArrayReader::fail(const QString& message) {
+    m_errorString = message;
+    m_buffer.clear();
+    m_pos = 0;
+}
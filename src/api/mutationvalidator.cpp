@@ -0,0 +1,72 @@
+#include "api/mutationvalidator.h"
+
+void MutationValidator::setDepartments(const QList<Department>& departments) {
+    m_departmentIds.clear();
+    m_departmentIds.reserve(departments.size());
+    for (const Department& department : departments)
+        m_departmentIds.insert(department.id);
+    m_departmentsLoaded = true;
+}
+
+void MutationValidator::setSalaryGrades(const QList<SalaryGrade>& grades) {
+    m_gradeIds.clear();
+    m_gradeIds.reserve(grades.size());
+    for (const SalaryGrade& grade : grades)
+        m_gradeIds.insert(grade.id);
+    m_gradesLoaded = true;
+}
+
+void MutationValidator::setEmployees(const QList<Employee>& employees, bool includesInactive) {
+    m_idByEmail.clear();
+    m_emailById.clear();
+    m_knownIds.clear();
+    m_idByEmail.reserve(employees.size());
+    m_emailById.reserve(employees.size());
+    m_knownIds.reserve(employees.size());
+    for (const Employee& employee : employees)
+        upsertEmployee(employee);
+    m_allEmployeesLoaded = includesInactive;
+}
+
+void MutationValidator::upsertEmployee(const Employee& employee) {
+    removeEmployee(employee.id);
+    m_knownIds.insert(employee.id);
+    const QString email = emailKey(employee.email);
+    m_emailById.insert(employee.id, email);
+    if (!email.isEmpty())
+        m_idByEmail.insert(email, employee.id);
+}
+
+void MutationValidator::removeEmployee(const QString& id) {
+    auto existing = m_emailById.find(id);
+    if (existing == m_emailById.end())
+        return;
+    if (m_idByEmail.value(*existing) == id)
+        m_idByEmail.remove(*existing);
+    m_emailById.erase(existing);
+}
+
+MutationValidator::Rejection MutationValidator::checkEmployee(const QString& id,
+                                                              const QJsonObject& fields) const {
+    const QString email = emailKey(fields.value("email").toString());
+    if (!email.isEmpty()) {
+        const QString owner = m_idByEmail.value(email);
+        if (!owner.isEmpty() && owner != id)
+            return {"email", "An employee with email " + email + " already exists"};
+    }
+
+    const QString departmentId = fields.value("department_id").toString();
+    if (m_departmentsLoaded && !departmentId.isEmpty() && !m_departmentIds.contains(departmentId))
+        return {"department_id", "Department " + departmentId + " does not exist"};
+
+    const QString gradeId = fields.value("salary_grade_id").toString();
+    if (m_gradesLoaded && !gradeId.isEmpty() && !m_gradeIds.contains(gradeId))
+        return {"salary_grade_id", "Salary grade " + gradeId + " does not exist"};
+
+    const QString managerId = fields.value("manager_id").toString();
+    // An active-only list cannot prove a manager missing; they may just be inactive
+    if (m_allEmployeesLoaded && !managerId.isEmpty() && !m_knownIds.contains(managerId))
+        return {"manager_id", "Manager " + managerId + " does not exist"};
+
+    return {};
+}
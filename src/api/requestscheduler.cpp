@@ -0,0 +1,226 @@
+#include "api/requestscheduler.h"
+
+#include <QDateTime>
+#include <QRandomGenerator>
+
+#include <algorithm>
+
+#ifdef DEBUG_API
+#include <QDebug>
+#endif
+
+namespace {
+
+bool isIdempotent(const QByteArray& verb) {
+    return verb == "GET" || verb == "PUT" || verb == "DELETE";
+}
+
+// Failures that say nothing about the request itself, so sending it again may work
+bool isTransient(QNetworkReply::NetworkError error) {
+    switch (error) {
+        case QNetworkReply::RemoteHostClosedError:
+        case QNetworkReply::TimeoutError:
+        case QNetworkReply::TemporaryNetworkFailureError:
+        case QNetworkReply::NetworkSessionFailedError:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+RequestScheduler::RequestScheduler(QNetworkAccessManager* manager, QObject* parent)
+    : QObject(parent), m_manager(manager), m_pauseTimer(new QTimer(this)) {
+    m_pauseTimer->setSingleShot(true);
+    connect(m_pauseTimer, &QTimer::timeout, this, &RequestScheduler::dispatch);
+}
+
+ScheduledRequest* RequestScheduler::submit(const QNetworkRequest& request, const QByteArray& verb,
+                                           Priority priority, const QByteArray& body) {
+    auto* scheduled = new ScheduledRequest(this);
+    scheduled->m_request = request;
+    scheduled->m_verb = verb;
+    scheduled->m_body = body;
+    scheduled->m_priority = priority;
+    m_queues[priority].append(scheduled);
+    dispatch();
+    return scheduled;
+}
+
+void RequestScheduler::promote(ScheduledRequest* request, Priority priority) {
+    if (priority >= request->m_priority)
+        return;
+    if (m_queues[request->m_priority].removeOne(request))
+        m_queues[priority].append(request);
+    request->m_priority = priority;
+    dispatch();
+}
+
+int RequestScheduler::queueDepth() const {
+    int depth = m_backingOff;
+    for (const QList<ScheduledRequest*>& queue : m_queues)
+        depth += static_cast<int>(queue.size());
+    return depth;
+}
+
+void RequestScheduler::dispatch() {
+    while (!throttled()) {
+        ScheduledRequest* next = takeNext();
+        if (!next)
+            break;
+        send(next);
+    }
+    emit stateChanged();
+}
+
+ScheduledRequest* RequestScheduler::takeNext() {
+    for (int priority = Interactive; priority < PriorityCount; ++priority) {
+        if (m_queues[priority].isEmpty())
+            continue;
+        int limit = concurrencyLimit();
+        if (priority != Interactive && limit > 1)
+            --limit;
+        // Lower classes wait too; this one is ahead of them
+        return m_inFlight < limit ? m_queues[priority].takeFirst() : nullptr;
+    }
+    return nullptr;
+}
+
+void RequestScheduler::send(ScheduledRequest* request) {
+    // Also orders the requests QNetworkAccessManager queues per host
+    switch (request->m_priority) {
+        case Interactive:
+            request->m_request.setPriority(QNetworkRequest::HighPriority);
+            break;
+        case Background:
+            request->m_request.setPriority(QNetworkRequest::NormalPriority);
+            break;
+        default:
+            request->m_request.setPriority(QNetworkRequest::LowPriority);
+            break;
+    }
+
+    QNetworkReply* reply = nullptr;
+    if (request->m_verb == "GET")
+        reply = m_manager->get(request->m_request);
+    else if (request->m_verb == "POST")
+        reply = m_manager->post(request->m_request, request->m_body);
+    else if (request->m_verb == "PUT")
+        reply = m_manager->put(request->m_request, request->m_body);
+    else if (request->m_verb == "DELETE")
+        reply = m_manager->deleteResource(request->m_request);
+    else
+        reply = m_manager->sendCustomRequest(request->m_request, request->m_verb, request->m_body);
+
+    // Goes away with the request, whichever of the two the caller deletes
+    reply->setParent(request);
+    request->m_reply = reply;
+    ++request->m_attempts;
+    request->m_sentAt.start();
+    ++m_inFlight;
+
+    connect(reply, &QNetworkReply::readyRead, request, [request, reply]() {
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status >= 200 && status < 300) {
+            request->m_delivered = true;
+            emit request->readyRead();
+        }
+    });
+    connect(reply, &QNetworkReply::finished, this, [this, request]() { onFinished(request); });
+}
+
+void RequestScheduler::onFinished(ScheduledRequest* request) {
+    --m_inFlight;
+    QNetworkReply* reply = request->m_reply;
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    int retryAfter = retryAfterMs(reply);
+
+    if (status == 429 || status == 503) {
+        ++m_throttledResponses;
+        m_limit = std::max(1.0, m_limit / 2);
+        // Everyone waits, not just this request; the server said it is overloaded
+        if (retryAfter > m_pauseTimer->remainingTime())
+            m_pauseTimer->start(retryAfter);
+    } else if (reply->error() == QNetworkReply::NoError) {
+        adaptToLatency(request->m_sentAt.elapsed());
+    }
+
+    if (!shouldRetry(request, status)) {
+        emit request->finished();
+        dispatch();
+        return;
+    }
+
+    int delay = retryAfter >= 0 ? retryAfter : backoffMs(request->m_attempts);
+#ifdef DEBUG_API
+    qDebug() << "Retrying" << request->m_verb << request->m_request.url() << "in" << delay
+             << "ms after" << (status ? QString::number(status) : reply->errorString());
+#endif
+    ++m_retries;
+    ++m_backingOff;
+    request->m_reply = nullptr;
+    reply->deleteLater();
+    QTimer::singleShot(delay, request, [this, request]() {
+        --m_backingOff;
+        // It already waited its turn once
+        m_queues[request->m_priority].prepend(request);
+        dispatch();
+    });
+    dispatch();
+}
+
+bool RequestScheduler::shouldRetry(const ScheduledRequest* request, int status) const {
+    if (request->m_delivered || request->m_attempts >= MaxAttempts)
+        return false;
+    // A 429 was turned away before it was processed, so even a POST is safe to repeat
+    if (status == 429)
+        return true;
+    if (!isIdempotent(request->m_verb))
+        return false;
+    if (status == 502 || status == 503 || status == 504)
+        return true;
+    return status == 0 && isTransient(request->m_reply->error());
+}
+
+void RequestScheduler::adaptToLatency(qint64 latencyMs) {
+    if (m_baselineMs < 0) {
+        m_baselineMs = m_smoothedMs = static_cast<double>(latencyMs);
+        return;
+    }
+    m_smoothedMs += (latencyMs - m_smoothedMs) * LatencySmoothing;
+    if (latencyMs < m_baselineMs)
+        m_baselineMs = static_cast<double>(latencyMs);
+    else
+        m_baselineMs += (latencyMs - m_baselineMs) * 0.01;
+
+    // Gentle multiplicative decrease. The increase is 1/limit per completed request, so a full
+    // window of `limit` completions, one round trip when the queue is busy, adds one request.
+    // Climbing back from 1 to MaxConcurrency takes 5 such round trips, 17 completions in all.
+    if (m_smoothedMs > m_baselineMs * LatencyTolerance)
+        m_limit = std::max(1.0, m_limit * 0.9);
+    else
+        m_limit = std::min<double>(MaxConcurrency, m_limit + 1.0 / m_limit);
+}
+
+int RequestScheduler::backoffMs(int attempt) {
+    int ceiling = std::min(BackoffCapMs, BackoffBaseMs << std::min(attempt - 1, 10));
+    // Half fixed, half random, so clients that failed together do not retry together
+    return ceiling / 2 + static_cast<int>(QRandomGenerator::global()->bounded(ceiling / 2 + 1));
+}
+
+int RequestScheduler::retryAfterMs(const QNetworkReply* reply) {
+    QByteArray value = reply->rawHeader("Retry-After").trimmed();
+    if (value.isEmpty())
+        return -1;
+
+    bool isSeconds = false;
+    qint64 ms = value.toLongLong(&isSeconds) * 1000;
+    if (!isSeconds) {
+        QDateTime at = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+        if (!at.isValid())
+            return -1;
+        ms = QDateTime::currentDateTimeUtc().msecsTo(at);
+    }
+    return static_cast<int>(std::clamp<qint64>(ms, 0, RetryAfterCapMs));
+}
@@ -0,0 +1,158 @@
+#include "api/snapshotcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#ifdef DEBUG_API
+#include <QDebug>
+#endif
+
+namespace {
+
+// Header: magic, format version, payload size, SHA-1 of the payload
+constexpr quint32 Magic = 0x504d5353; // "PMSS"
+constexpr int ChecksumSize = 20;
+constexpr int HeaderSize = 4 + 4 + 8 + ChecksumSize;
+constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_0;
+
+void writeEntity(QDataStream& out, const Department& dept) {
+    out << dept.id << dept.name << dept.headId << dept.createdAt << dept.updatedAt;
+}
+
+void writeEntity(QDataStream& out, const Employee& emp) {
+    out << emp.id << emp.firstName << emp.lastName << emp.email << emp.role << emp.active
+        << emp.departmentId << emp.managerId << emp.salaryGradeId << emp.hireDate
+        << emp.createdAt << emp.updatedAt << emp.deletedAt;
+}
+
+void writeEntity(QDataStream& out, const SalaryGrade& grade) {
+    out << grade.id << grade.code << grade.baseSalary << grade.description << grade.createdAt;
+}
+
+void readEntity(QDataStream& in, Department& dept) {
+    in >> dept.id >> dept.name >> dept.headId >> dept.createdAt >> dept.updatedAt;
+}
+
+void readEntity(QDataStream& in, Employee& emp) {
+    in >> emp.id >> emp.firstName >> emp.lastName >> emp.email >> emp.role >> emp.active >>
+        emp.departmentId >> emp.managerId >> emp.salaryGradeId >> emp.hireDate >>
+        emp.createdAt >> emp.updatedAt >> emp.deletedAt;
+}
+
+void readEntity(QDataStream& in, SalaryGrade& grade) {
+    in >> grade.id >> grade.code >> grade.baseSalary >> grade.description >> grade.createdAt;
+}
+
+template <typename T>
+void writeList(QDataStream& out, const QList<T>& items) {
+    out << static_cast<quint32>(items.size());
+    for (const T& item : items)
+        writeEntity(out, item);
+}
+
+template <typename T>
+bool readList(QDataStream& in, QList<T>& items) {
+    quint32 count = 0;
+    in >> count;
+    items.reserve(count);
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        T item;
+        readEntity(in, item);
+        items.append(item);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+bool readSnapshot(const QByteArray& raw, Snapshot& snapshot) {
+    QDataStream header(raw);
+    header.setVersion(StreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint64 payloadSize = 0;
+    header >> magic >> version >> payloadSize;
+    if (magic != Magic || version != SnapshotCache::FormatVersion ||
+        payloadSize != static_cast<quint64>(raw.size() - HeaderSize))
+        return false;
+
+    QByteArray payload =
+        QByteArray::fromRawData(raw.constData() + HeaderSize, raw.size() - HeaderSize);
+    QByteArray checksum = QByteArray::fromRawData(raw.constData() + HeaderSize - ChecksumSize,
+                                                  ChecksumSize);
+    if (QCryptographicHash::hash(payload, QCryptographicHash::Sha1) != checksum)
+        return false;
+
+    QDataStream in(payload);
+    in.setVersion(StreamVersion);
+    Snapshot result;
+    if (!readList(in, result.departments) || !readList(in, result.employees) ||
+        !readList(in, result.salaryGrades) || !in.atEnd())
+        return false;
+
+    snapshot = result;
+    return true;
+}
+
+} // namespace
+
+SnapshotCache::SnapshotCache(const QString& filePath) : m_filePath(filePath) {}
+
+QString SnapshotCache::defaultPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/snapshot.bin";
+}
+
+bool SnapshotCache::load(Snapshot& snapshot) const {
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < HeaderSize)
+        return false;
+
+    uchar* mapped = file.map(0, file.size());
+    if (!mapped)
+        return false;
+
+    bool loaded = false;
+    {
+        // Read straight from the mapping; the entities copy out what they keep
+        QByteArray raw =
+            QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), file.size());
+        loaded = readSnapshot(raw, snapshot);
+    }
+    file.unmap(mapped);
+
+#ifdef DEBUG_API
+    qDebug() << "Snapshot" << m_filePath << (loaded ? "loaded" : "rejected");
+#endif
+    return loaded;
+}
+
+bool SnapshotCache::save(const Snapshot& snapshot) const {
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(StreamVersion);
+        writeList(out, snapshot.departments);
+        writeList(out, snapshot.employees);
+        writeList(out, snapshot.salaryGrades);
+    }
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(StreamVersion);
+    out << Magic << FormatVersion << static_cast<quint64>(payload.size());
+    out.writeRawData(QCryptographicHash::hash(payload, QCryptographicHash::Sha1).constData(),
+                     ChecksumSize);
+    out.writeRawData(payload.constData(), static_cast<int>(payload.size()));
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+void SnapshotCache::invalidate() const {
+    QFile::remove(m_filePath);
+}
@@ -1,32 +1,102 @@
 #include "gui/personnelapp.h"
 
 #include <QJsonObject>
+#include <QtConcurrent>
 
 PersonnelApp::PersonnelApp(QObject* parent)
     : QObject(parent), m_apiClient(new ApiClient(this)), m_colors(new Material3Colors(true, this)),
-      m_currentTab(0), m_darkMode(true) {
+      m_currentTab(0), m_darkMode(true), m_departmentModel(new DepartmentListModel(this)),
+      m_employeeModel(new EmployeeListModel(this)),
+      m_salaryGradeModel(new SalaryGradeListModel(this)), m_payrollModel(new PayrollModel(this)),
+      m_salaryStatistics(new SalaryStatisticsModel(this)), m_snapshotTimer(new QTimer(this)),
+      m_snapshotSave(new QFutureWatcher<void>(this)) {
+    // Resolved roles (department name, grade label, head name) come from the sibling models
+    m_employeeModel->setDepartmentModel(m_departmentModel);
+    m_employeeModel->setSalaryGradeModel(m_salaryGradeModel);
+    m_departmentModel->setEmployeeModel(m_employeeModel);
+    m_payrollModel->setEmployeeModel(m_employeeModel);
+    m_payrollModel->setSalaryGradeModel(m_salaryGradeModel);
+    m_payrollModel->setDepartmentModel(m_departmentModel);
+    m_salaryStatistics->setEmployeeModel(m_employeeModel);
+    m_salaryStatistics->setSalaryGradeModel(m_salaryGradeModel);
+    m_salaryStatistics->setDepartmentModel(m_departmentModel);
+
     // Connect signals
     connect(m_apiClient, &ApiClient::departmentsReceived, this,
             &PersonnelApp::onDepartmentsReceived);
     connect(m_apiClient, &ApiClient::employeesReceived, this, &PersonnelApp::onEmployeesReceived);
+    // Rows show up while the list downloads; the final list then settles order and removals
+    connect(m_apiClient, &ApiClient::employeesBatchReceived, m_employeeModel,
+            &EmployeeListModel::upsertAll);
     connect(m_apiClient, &ApiClient::salaryGradesReceived, this,
             &PersonnelApp::onSalaryGradesReceived);
     connect(m_apiClient, &ApiClient::operationCompleted, this, &PersonnelApp::onOperationCompleted);
     connect(m_apiClient, &ApiClient::errorOccurred, this, &PersonnelApp::onErrorOccurred);
 
-    // Load initial data
-    refreshDepartments();
-    refreshEmployees();
-    refreshSalaryGrades();
+    // Mutations patch the models directly instead of reloading every collection
+    connect(m_apiClient, &ApiClient::departmentSaved, m_departmentModel,
+            &DepartmentListModel::upsert);
+    connect(m_apiClient, &ApiClient::departmentDeleted, m_departmentModel,
+            &DepartmentListModel::removeId);
+    connect(m_apiClient, &ApiClient::employeeSaved, this, &PersonnelApp::onEmployeeSaved);
+    connect(m_apiClient, &ApiClient::employeeDeleted, m_employeeModel,
+            &EmployeeListModel::removeId);
+    connect(m_apiClient, &ApiClient::salaryGradeSaved, m_salaryGradeModel,
+            &SalaryGradeListModel::upsert);
+    connect(m_apiClient, &ApiClient::salaryGradeDeleted, m_salaryGradeModel,
+            &SalaryGradeListModel::removeId);
+    connect(m_apiClient, &ApiClient::resyncRequired, this, &PersonnelApp::onResyncRequired);
+    connect(m_apiClient, &ApiClient::notModified, this, &PersonnelApp::onNotModified);
+
+    m_snapshotTimer->setSingleShot(true);
+    m_snapshotTimer->setInterval(SnapshotDelayMs);
+    connect(m_snapshotTimer, &QTimer::timeout, this, &PersonnelApp::saveSnapshot);
+    connect(m_snapshotSave, &QFutureWatcherBase::finished, this,
+            &PersonnelApp::startPendingSnapshot);
+
+    // Render the last synced state right away; the refreshes below reconcile it
+    Snapshot snapshot;
+    if (m_snapshotCache.load(snapshot)) {
+        m_departmentModel->setItems(snapshot.departments);
+        m_employeeModel->setItems(snapshot.employees);
+        m_salaryGradeModel->setItems(snapshot.salaryGrades);
+    }
+
+    // Load initial data; what the first tab shows goes ahead of the rest
+    QList<ApiClient::Collection> visible = collectionsOnTab(m_currentTab);
+    auto priorityOf = [&visible](ApiClient::Collection collection) {
+        return visible.contains(collection) ? RequestScheduler::Interactive
+                                            : RequestScheduler::Background;
+    };
+    m_apiClient->getDepartments(priorityOf(ApiClient::Departments));
+    m_apiClient->getEmployees(false, priorityOf(ApiClient::Employees));
+    m_apiClient->getSalaryGrades(priorityOf(ApiClient::SalaryGrades));
 }
 
 void PersonnelApp::setCurrentTab(int tab) {
     if (m_currentTab != tab) {
         m_currentTab = tab;
+        // A fetch the new tab waits for should not stay queued behind background work
+        for (ApiClient::Collection collection : collectionsOnTab(tab))
+            m_apiClient->prioritize(collection);
         emit currentTabChanged();
     }
 }
 
+QList<ApiClient::Collection> PersonnelApp::collectionsOnTab(int tab) const {
+    switch (tab) {
+        case 0:
+            // Department cards show their head's name
+            return {ApiClient::Departments, ApiClient::Employees};
+        case 1:
+            return {ApiClient::Employees, ApiClient::Departments, ApiClient::SalaryGrades};
+        case 2:
+            return {ApiClient::SalaryGrades};
+        default:
+            return {};
+    }
+}
+
 void PersonnelApp::setDarkMode(bool dark) {
     if (m_darkMode != dark) {
         m_darkMode = dark;
@@ -50,22 +120,37 @@ void PersonnelApp::updateDepartment(const QString& id, const QString& name, cons
 
 void PersonnelApp::updateDepartmentWithHead(const QString& deptId, const QString& name,
                                             const QString& newHeadId, const QString& oldHeadId) {
-    // Update the department first
-    m_apiClient->updateDepartment(deptId, name, newHeadId);
+    // Sent as one batch so a failed step rolls the others back instead of leaving the
+    // department and its heads' roles disagreeing
+    QList<ApiClient::Mutation> mutations;
+
+    ApiClient::Mutation department{"PUT", ApiClient::Departments, deptId, {}, {}};
+    if (!name.isEmpty())
+        department.data["name"] = name;
+    if (!newHeadId.isEmpty())
+        department.data["head_id"] = newHeadId;
+    if (const Department* current = m_departmentModel->itemById(deptId))
+        department.undoData = current->toRestoreJson();
+    mutations.append(department);
+
+    auto roleChange = [this](const QString& employeeId, const QString& role) {
+        ApiClient::Mutation mutation{"PUT", ApiClient::Employees, employeeId, {}, {}};
+        mutation.data["role"] = role;
+        const Employee* current = m_employeeModel->itemById(employeeId);
+        if (current && !current->role.isEmpty())
+            mutation.undoData["role"] = current->role;
+        return mutation;
+    };
 
     // If there was an old head and it's different from the new one, update their role
-    if (!oldHeadId.isEmpty() && oldHeadId != newHeadId) {
-        QJsonObject oldHeadUpdate;
-        oldHeadUpdate["role"] = "Employee";
-        m_apiClient->updateEmployee(oldHeadId, oldHeadUpdate);
-    }
+    if (!oldHeadId.isEmpty() && oldHeadId != newHeadId)
+        mutations.append(roleChange(oldHeadId, "Employee"));
 
     // If there's a new head, update their role to DepartmentHead (no space - API format)
-    if (!newHeadId.isEmpty()) {
-        QJsonObject newHeadUpdate;
-        newHeadUpdate["role"] = "DepartmentHead";
-        m_apiClient->updateEmployee(newHeadId, newHeadUpdate);
-    }
+    if (!newHeadId.isEmpty())
+        mutations.append(roleChange(newHeadId, "DepartmentHead"));
+
+    m_apiClient->submitBatch(mutations);
 }
 
 void PersonnelApp::deleteDepartment(const QString& id) {
@@ -83,6 +168,18 @@ void PersonnelApp::createEmployee(const QString& firstName, const QString& lastN
 }
 
 void PersonnelApp::updateEmployee(const QString& id, const QVariantMap& updates) {
+    // Caught before sending; a reporting loop would break every chain-of-command query
+    const QString managerId = updates.value("manager_id").toString();
+    if (m_employeeModel->wouldCreateCycle(id, managerId)) {
+        if (managerId == id)
+            m_errorMessage = "An employee cannot be their own manager";
+        else
+            m_errorMessage = m_employeeModel->fullNameOf(managerId) + " reports to " +
+                             m_employeeModel->fullNameOf(id) + ", so cannot be their manager";
+        emit errorMessageChanged();
+        return;
+    }
+
     QJsonObject json;
     for (auto it = updates.begin(); it != updates.end(); ++it) {
         json[it.key()] = QJsonValue::fromVariant(it.value());
@@ -112,27 +209,79 @@ void PersonnelApp::deleteSalaryGrade(const QString& id) {
     m_apiClient->deleteSalaryGrade(id);
 }
 
+void PersonnelApp::invalidateSnapshot() {
+    m_snapshotTimer->stop();
+    m_pendingSnapshot.reset();
+    // A save cannot be stopped halfway; let it finish so it does not bring the file back
+    m_snapshotSave->waitForFinished();
+    m_snapshotCache.invalidate();
+}
+
 void PersonnelApp::onDepartmentsReceived(QList<Department> departments) {
-    m_departments = departments;
-    emit departmentsChanged();
+    m_departmentModel->setItems(departments);
+    markSynced(ApiClient::Departments);
 }
 
 void PersonnelApp::onEmployeesReceived(QList<Employee> employees) {
-    m_employees = employees;
-    emit employeesChanged();
+    m_employeeModel->setItems(employees);
+    markSynced(ApiClient::Employees);
 }
 
 void PersonnelApp::onSalaryGradesReceived(QList<SalaryGrade> grades) {
-    m_salaryGrades = grades;
-    emit salaryGradesChanged();
+    m_salaryGradeModel->setItems(grades);
+    markSynced(ApiClient::SalaryGrades);
+}
+
+void PersonnelApp::markSynced(ApiClient::Collection collection) {
+    m_syncedCollections.insert(collection);
+    scheduleSnapshot();
+}
+
+void PersonnelApp::scheduleSnapshot() {
+    // Only persist once every collection has come from the server this session
+    if (m_syncedCollections.size() == 3)
+        m_snapshotTimer->start();
+}
+
+void PersonnelApp::saveSnapshot() {
+    // The lists are implicitly shared copies, so serializing off the GUI thread is safe.
+    // One save runs at a time, so an older snapshot can never land after a newer one;
+    // while it runs, only the latest snapshot waits to be written next.
+    m_pendingSnapshot = Snapshot{departments(), employees(), salaryGrades()};
+    if (m_snapshotSave->isRunning())
+        return;
+    startPendingSnapshot();
+}
+
+void PersonnelApp::startPendingSnapshot() {
+    if (!m_pendingSnapshot)
+        return;
+    Snapshot snapshot = std::move(*m_pendingSnapshot);
+    m_pendingSnapshot.reset();
+    m_snapshotSave->setFuture(
+        QtConcurrent::run([cache = m_snapshotCache, snapshot]() { cache.save(snapshot); }));
+}
+
+void PersonnelApp::onEmployeeSaved(Employee employee) {
+    // The list only holds active employees, so a deactivation takes the row out
+    if (!employee.active || employee.deletedAt.isValid())
+        m_employeeModel->removeId(employee.id);
+    else
+        m_employeeModel->upsert(employee);
+}
+
+void PersonnelApp::onResyncRequired(ApiClient::Collection collection) {
+    m_apiClient->requestRefresh(collection);
+}
+
+void PersonnelApp::onNotModified(ApiClient::Collection collection) {
+    // The model already holds the current list
+    markSynced(collection);
 }
 
 void PersonnelApp::onOperationCompleted(bool success, const QString& message) {
     if (success) {
-        // Refresh data after successful operation
-        refreshDepartments();
-        refreshEmployees();
-        refreshSalaryGrades();
+        scheduleSnapshot();
         m_errorMessage.clear();
     } else {
         m_errorMessage = message;
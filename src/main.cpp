@@ -1,6 +1,15 @@
+#include "api/apiclient.h"
+#include "api/employeeimporter.h"
 #include "gui/material3colors.h"
 #include "gui/personnelapp.h"
-
+#include "models/departmentfiltermodel.h"
+#include "models/employeecompletionmodel.h"
+#include "models/employeefiltermodel.h"
+#include "models/payrollmodel.h"
+#include "models/salarystatisticsmodel.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QFontDatabase>
@@ -8,8 +17,83 @@
 #include <QIcon>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QTextStream>
+
+#include <cstring>
+
+namespace {
+
+// Headless bulk import, e.g. `personnel_management --import staff.csv --window 16`. Exits
+// with 0 when every row went through, 1 when some rows failed and 2 when the import stopped.
+int runImport(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Personnel Management System");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Imports employees from a CSV or JSON file.");
+    parser.addHelpOption();
+    QCommandLineOption importOption("import", "CSV or JSON file to import.", "file");
+    QCommandLineOption windowOption("window", "Requests kept in flight at once.", "count",
+                                    QString::number(EmployeeImporter::DefaultWindow));
+    QCommandLineOption resumeOption("resume", "Skip rows an interrupted import already sent.");
+    QCommandLineOption apiUrlOption("api-url", "API URL to use instead of the configured one.",
+                                    "url");
+    parser.addOptions({importOption, windowOption, resumeOption, apiUrlOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    ApiClient client;
+    if (parser.isSet(apiUrlOption))
+        client.setApiUrl(parser.value(apiUrlOption));
+    EmployeeImporter importer(&client);
+
+    EmployeeImporter::Options options;
+    options.window = parser.value(windowOption).toInt();
+    options.resume = parser.isSet(resumeOption);
+
+    QObject::connect(&importer, &EmployeeImporter::progress,
+                     [&out](int processed, double rowsPerSecond) {
+                         out << processed << " rows, " << qRound(rowsPerSecond) << " rows/s\r"
+                             << Qt::flush;
+                     });
+    QObject::connect(&importer, &EmployeeImporter::rowFailed,
+                     [&err](int row, const QString& reason) {
+                         err << "Row " << row << ": " << reason << Qt::endl;
+                     });
+    auto printSummary = [&out, &importer]() {
+        const EmployeeImporter::Summary& summary = importer.summary();
+        out << "\nImported " << summary.imported << ", failed " << summary.failed
+            << ", skipped " << summary.skipped << " in " << summary.elapsedMs << " ms ("
+            << qRound(summary.rowsPerSecond()) << " rows/s)" << Qt::endl;
+    };
+    QObject::connect(&importer, &EmployeeImporter::finished, [&]() {
+        printSummary();
+        app.exit(importer.summary().failed == 0 ? 0 : 1);
+    });
+    QObject::connect(&importer, &EmployeeImporter::failed, [&](const QString& error) {
+        printSummary();
+        err << error << Qt::endl;
+        app.exit(2);
+    });
+
+    if (!importer.start(parser.value(importOption), options)) {
+        err << importer.errorString() << Qt::endl;
+        return 2;
+    }
+    return app.exec();
+}
+
+} // namespace
 
 int main(int argc, char* argv[]) {
+    // The importer runs without a GUI, so it has to be picked before any application exists
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--import") == 0 || std::strncmp(argv[i], "--import=", 9) == 0)
+            return runImport(argc, argv);
+    }
+
     QGuiApplication app(argc, argv);
 
     // Set application metadata
@@ -59,6 +143,15 @@ int main(int argc, char* argv[]) {
     // Register custom types
     qmlRegisterUncreatableType<Material3Colors>("PersonnelManagement", 1, 0, "Material3Colors",
                                                 "Material3Colors cannot be created from QML");
+    qmlRegisterType<EmployeeFilterModel>("PersonnelManagement", 1, 0, "EmployeeFilterModel");
+    qmlRegisterType<DepartmentFilterModel>("PersonnelManagement", 1, 0, "DepartmentFilterModel");
+    qmlRegisterType<EmployeeCompletionModel>("PersonnelManagement", 1, 0,
+                                             "EmployeeCompletionModel");
+    qmlRegisterUncreatableType<PayrollModel>("PersonnelManagement", 1, 0, "PayrollModel",
+                                             "Use personnelApp.payrollModel");
+    qmlRegisterUncreatableType<SalaryStatisticsModel>("PersonnelManagement", 1, 0,
+                                                      "SalaryStatisticsModel",
+                                                      "Use personnelApp.salaryStatistics");
 
     // Create app instance
     PersonnelApp personnelApp;
@@ -1,5 +1,10 @@
 #include "gui/material3colors.h"
 #include "gui/personnelapp.h"
+#include "models/departmentfiltermodel.h"
+#include "models/employeecompletionmodel.h"
+#include "models/employeefiltermodel.h"
+#include "models/payrollmodel.h"
+#include "models/salarystatisticsmodel.h"
 
 #include <QDir>
 #include <QGuiApplication>
@@ -29,6 +34,15 @@ int main(int argc, char* argv[]) {
     // Register custom types
     qmlRegisterUncreatableType<Material3Colors>("PersonnelManagement", 1, 0, "Material3Colors",
                                                 "Material3Colors cannot be created from QML");
+    qmlRegisterType<EmployeeFilterModel>("PersonnelManagement", 1, 0, "EmployeeFilterModel");
+    qmlRegisterType<DepartmentFilterModel>("PersonnelManagement", 1, 0, "DepartmentFilterModel");
+    qmlRegisterType<EmployeeCompletionModel>("PersonnelManagement", 1, 0,
+                                             "EmployeeCompletionModel");
+    qmlRegisterUncreatableType<PayrollModel>("PersonnelManagement", 1, 0, "PayrollModel",
+                                             "Use personnelApp.payrollModel");
+    qmlRegisterUncreatableType<SalaryStatisticsModel>("PersonnelManagement", 1, 0,
+                                                      "SalaryStatisticsModel",
+                                                      "Use personnelApp.salaryStatistics");
 
     // Create app instance
     PersonnelApp personnelApp;
@@ -0,0 +1,166 @@
+#include "models/asyncfiltermodel.h"
+
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include <climits>
+#include <utility>
+
+AsyncFilterModel::AsyncFilterModel(QObject* parent) : QSortFilterProxyModel(parent) {
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(DefaultDebounceMs);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &AsyncFilterModel::startMatch);
+
+    connect(this, &QAbstractItemModel::rowsInserted, this, &AsyncFilterModel::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &AsyncFilterModel::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &AsyncFilterModel::countChanged);
+    connect(this, &QAbstractItemModel::layoutChanged, this, &AsyncFilterModel::countChanged);
+}
+
+void AsyncFilterModel::setFilterText(const QString& text) {
+    if (m_filterText == text)
+        return;
+    m_filterText = text;
+
+    if (m_filterText.trimmed().isEmpty()) {
+        // Clearing the search needs no matching, so it takes effect right away
+        m_debounceTimer.stop();
+        ++m_matchGeneration;
+        applyRanks(QString(), Ranks(), m_sourceRevision);
+        setBusy(false);
+    } else {
+        setBusy(true);
+        m_debounceTimer.start();
+    }
+    emit filterTextChanged();
+}
+
+void AsyncFilterModel::setDebounceInterval(int msec) {
+    if (m_debounceTimer.interval() == msec)
+        return;
+    m_debounceTimer.setInterval(msec);
+    emit debounceIntervalChanged();
+}
+
+void AsyncFilterModel::setSourceModel(QAbstractItemModel* model) {
+    for (const QMetaObject::Connection& connection : std::as_const(m_sourceConnections))
+        disconnect(connection);
+    m_sourceConnections.clear();
+
+    if (model) {
+        m_sourceConnections = {
+            connect(model, &QAbstractItemModel::dataChanged, this,
+                    &AsyncFilterModel::sourceDataChanged),
+            connect(model, &QAbstractItemModel::rowsInserted, this,
+                    &AsyncFilterModel::sourceDataChanged),
+            connect(model, &QAbstractItemModel::rowsRemoved, this,
+                    &AsyncFilterModel::sourceDataChanged),
+            connect(model, &QAbstractItemModel::modelReset, this,
+                    &AsyncFilterModel::sourceDataChanged),
+        };
+    }
+    QSortFilterProxyModel::setSourceModel(model);
+
+    // Always sorted: by source row without a query, by rank with one
+    if (model)
+        sort(0);
+    sourceDataChanged();
+}
+
+bool AsyncFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const {
+    Q_UNUSED(sourceParent)
+    if (m_appliedQuery.isEmpty())
+        return true;
+
+    QString id = idOfRow(sourceRow);
+    return id.isEmpty() || m_ranks.contains(id);
+}
+
+bool AsyncFilterModel::lessThan(const QModelIndex& left, const QModelIndex& right) const {
+    if (!m_appliedQuery.isEmpty()) {
+        int leftRank = m_ranks.value(idOfRow(left.row()), INT_MAX);
+        int rightRank = m_ranks.value(idOfRow(right.row()), INT_MAX);
+        if (leftRank != rightRank)
+            return leftRank < rightRank;
+    }
+    return left.row() < right.row();
+}
+
+void AsyncFilterModel::sourceDataChanged() {
+    // Rows that arrive or change meanwhile keep their old verdict until the re-match lands
+    ++m_sourceRevision;
+    m_ranksCurrent = false;
+    if (!m_filterText.trimmed().isEmpty()) {
+        setBusy(true);
+        m_debounceTimer.start();
+    }
+}
+
+void AsyncFilterModel::startMatch() {
+    const QString query = m_filterText.trimmed().toLower();
+    if (query.isEmpty())
+        return;
+
+    // Anything matching the longer query also matched the one it contains
+    bool narrow = m_ranksCurrent && !m_appliedQuery.isEmpty() && query.contains(m_appliedQuery);
+    MatchJob job = createMatchJob(query, narrow ? &m_ranks : nullptr);
+
+    const quint64 generation = ++m_matchGeneration;
+    const quint64 sourceRevision = m_sourceRevision;
+    auto* watcher = new QFutureWatcher<Ranks>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this,
+            [this, watcher, generation, sourceRevision, query]() {
+                watcher->deleteLater();
+                // A newer match has started since; its results will follow
+                if (generation != m_matchGeneration)
+                    return;
+                applyRanks(query, watcher->result(), sourceRevision);
+                setBusy(m_debounceTimer.isActive());
+            });
+    watcher->setFuture(QtConcurrent::run(std::move(job)));
+}
+
+void AsyncFilterModel::applyRanks(const QString& query, const Ranks& ranks,
+                                  quint64 sourceRevision) {
+    bool orderHolds = visibleOrderHolds(query, ranks);
+    m_appliedQuery = query;
+    m_ranks = ranks;
+    m_ranksCurrent = sourceRevision == m_sourceRevision;
+
+    // Filtering alone removes and inserts rows in place; only when rows that stay visible
+    // have to swap places does the whole layout change
+    if (orderHolds)
+        invalidateFilter();
+    else
+        invalidate();
+}
+
+bool AsyncFilterModel::visibleOrderHolds(const QString& query, const Ranks& ranks) const {
+    if (!sourceModel())
+        return true;
+
+    int previousRank = INT_MIN;
+    int previousRow = -1;
+    for (int row = 0; row < rowCount(); ++row) {
+        int sourceRow = mapToSource(index(row, 0)).row();
+        int rank = 0;
+        if (!query.isEmpty()) {
+            QString id = idOfRow(sourceRow);
+            if (!id.isEmpty() && !ranks.contains(id))
+                continue; // About to be filtered out
+            rank = ranks.value(id, INT_MAX);
+        }
+        if (rank < previousRank || (rank == previousRank && sourceRow < previousRow))
+            return false;
+        previousRank = rank;
+        previousRow = sourceRow;
+    }
+    return true;
+}
+
+void AsyncFilterModel::setBusy(bool busy) {
+    if (m_busy == busy)
+        return;
+    m_busy = busy;
+    emit busyChanged();
+}
@@ -0,0 +1,85 @@
+#include "models/compactemployee.h"
+
+#include "models/stringtable.h"
+
+#include <QTimeZone>
+
+CompactEmployee CompactEmployee::fromEmployee(const Employee& employee) {
+    CompactEmployee compact;
+    compact.id = CompactId::fromString(employee.id);
+    compact.departmentId = CompactId::fromString(employee.departmentId);
+    compact.managerId = CompactId::fromString(employee.managerId);
+    compact.salaryGradeId = CompactId::fromString(employee.salaryGradeId);
+    compact.role = StringTable::roles().intern(employee.role);
+    compact.active = employee.active;
+    compact.setText(employee.firstName, employee.lastName, employee.email);
+    compact.setDateTime(HireDate, employee.hireDate);
+    compact.setDateTime(CreatedAt, employee.createdAt);
+    compact.setDateTime(UpdatedAt, employee.updatedAt);
+    compact.setDateTime(DeletedAt, employee.deletedAt);
+    return compact;
+}
+
+Employee CompactEmployee::toEmployee() const {
+    Employee employee;
+    employee.id = idString();
+    employee.firstName = firstNameString();
+    employee.lastName = lastNameString();
+    employee.email = emailString();
+    employee.role = roleString();
+    employee.active = active;
+    employee.departmentId = departmentIdString();
+    employee.managerId = managerIdString();
+    employee.salaryGradeId = salaryGradeIdString();
+    employee.hireDate = hireDate();
+    employee.createdAt = createdAt();
+    employee.updatedAt = updatedAt();
+    employee.deletedAt = deletedAt();
+    return employee;
+}
+
+void CompactEmployee::setText(const QString& firstName, const QString& lastName,
+                              const QString& email) {
+    m_text = firstName + lastName + email;
+    m_firstNameLength = static_cast<int>(firstName.size());
+    m_lastNameLength = static_cast<int>(lastName.size());
+}
+
+QDateTime CompactEmployee::dateTime(Timestamp which) const {
+    const qint64 msecs = m_epochMs[which];
+    if (msecs == NoTime)
+        return QDateTime();
+    const qint32 offset = m_offsets[which];
+    if (offset == LocalTime)
+        return QDateTime::fromMSecsSinceEpoch(msecs);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    return QDateTime::fromMSecsSinceEpoch(msecs, QTimeZone::fromSecondsAheadOfUtc(offset));
+#else
+    // An offset of 0 comes back as Qt::UTC, as it does from QDateTime's own constructor
+    return QDateTime::fromMSecsSinceEpoch(msecs, Qt::OffsetFromUTC, offset);
+#endif
+}
+
+void CompactEmployee::setDateTime(Timestamp which, const QDateTime& dateTime) {
+    if (!dateTime.isValid()) {
+        m_epochMs[which] = NoTime;
+        m_offsets[which] = 0;
+        return;
+    }
+    m_epochMs[which] = dateTime.toMSecsSinceEpoch();
+    m_offsets[which] =
+        dateTime.timeSpec() == Qt::LocalTime ? LocalTime : dateTime.offsetFromUtc();
+}
+
+QString CompactEmployee::roleString() const {
+    return StringTable::roles().at(role);
+}
+
+bool CompactEmployee::operator==(const CompactEmployee& other) const {
+    // Like QDateTime's, timestamps are equal when they are the same instant
+    return id == other.id && departmentId == other.departmentId &&
+           managerId == other.managerId && salaryGradeId == other.salaryGradeId &&
+           role == other.role && active == other.active && m_epochMs == other.m_epochMs &&
+           m_firstNameLength == other.m_firstNameLength &&
+           m_lastNameLength == other.m_lastNameLength && m_text == other.m_text;
+}
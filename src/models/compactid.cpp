@@ -0,0 +1,87 @@
+#include "models/compactid.h"
+
+#include "models/stringtable.h"
+
+namespace {
+
+constexpr int UuidLength = 36;
+
+int hexValue(char16_t c) {
+    if (c >= u'0' && c <= u'9')
+        return c - u'0';
+    if (c >= u'a' && c <= u'f')
+        return c - u'a' + 10;
+    // Upper case is not canonical; it goes to the string table to keep its spelling
+    return -1;
+}
+
+bool isDash(int pos) {
+    return pos == 8 || pos == 13 || pos == 18 || pos == 23;
+}
+
+} // namespace
+
+bool CompactId::parseUuid(QStringView text, quint64& high, quint64& low) {
+    if (text.size() != UuidLength)
+        return false;
+    high = 0;
+    low = 0;
+    int nibbles = 0;
+    for (int pos = 0; pos < UuidLength; ++pos) {
+        const char16_t c = text[pos].unicode();
+        if (isDash(pos)) {
+            if (c != u'-')
+                return false;
+            continue;
+        }
+        const int value = hexValue(c);
+        if (value < 0)
+            return false;
+        quint64& half = nibbles < 16 ? high : low;
+        half = (half << 4) | static_cast<quint64>(value);
+        ++nibbles;
+    }
+    // Other variants could collide with the interned encoding
+    return (low >> 62) == 0x2;
+}
+
+CompactId CompactId::fromString(const QString& text) {
+    CompactId id;
+    if (text.isEmpty() || parseUuid(text, id.m_high, id.m_low))
+        return id;
+    id.m_high = 0;
+    id.m_low = quint64(StringTable::ids().intern(text)) + 1;
+    return id;
+}
+
+CompactId CompactId::find(const QString& text) {
+    CompactId id;
+    if (text.isEmpty() || parseUuid(text, id.m_high, id.m_low))
+        return id;
+    id.m_high = 0;
+    id.m_low = quint64(StringTable::ids().indexOf(text) + 1);
+    return id;
+}
+
+QString CompactId::toString() const {
+    if (isNull())
+        return QString();
+    if (!isUuid())
+        return StringTable::ids().at(static_cast<quint32>(m_low - 1));
+
+    static constexpr char16_t Digits[] = u"0123456789abcdef";
+    QString text(UuidLength, Qt::Uninitialized);
+    QChar* out = text.data();
+    int nibble = 0;
+    for (int pos = 0; pos < UuidLength; ++pos) {
+        if (isDash(pos)) {
+            out[pos] = u'-';
+            continue;
+        }
+        const quint64 half = nibble < 16 ? m_high : m_low;
+        const int shift = 60 - 4 * (nibble % 16);
+        out[pos] = Digits[(half >> shift) & 0xf];
+        ++nibble;
+    }
+    return text;
+}
@@ -1,5 +1,7 @@
 #include "models/department.h"
 
+#include "models/isodatetime.h"
+
 #include <QJsonValue>
 
 Department Department::fromJson(const QJsonObject& json) {
@@ -8,12 +10,8 @@ Department Department::fromJson(const QJsonObject& json) {
     dept.name = json["name"].toString();
     dept.headId = json["head_id"].toString();
 
-    if (json.contains("created_at") && !json["created_at"].isNull()) {
-        dept.createdAt = QDateTime::fromString(json["created_at"].toString(), Qt::ISODate);
-    }
-    if (json.contains("updated_at") && !json["updated_at"].isNull()) {
-        dept.updatedAt = QDateTime::fromString(json["updated_at"].toString(), Qt::ISODate);
-    }
+    dept.createdAt = parseIsoDateTime(json.value("created_at"));
+    dept.updatedAt = parseIsoDateTime(json.value("updated_at"));
 
     return dept;
 }
@@ -26,3 +24,15 @@ QJsonObject Department::toJson() const {
     }
     return json;
 }
+
+QJsonObject Department::toRestoreJson() const {
+    QJsonObject json;
+    json["name"] = name;
+    json["head_id"] = headId.isEmpty() ? QJsonValue(QJsonValue::Null) : QJsonValue(headId);
+    return json;
+}
+
+bool Department::operator==(const Department& other) const {
+    return id == other.id && name == other.name && headId == other.headId &&
+           createdAt == other.createdAt && updatedAt == other.updatedAt;
+}
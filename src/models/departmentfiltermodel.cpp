@@ -0,0 +1,72 @@
+#include "models/departmentfiltermodel.h"
+
+#include <QSet>
+
+DepartmentFilterModel::DepartmentFilterModel(QObject* parent) : AsyncFilterModel(parent) {}
+
+void DepartmentFilterModel::setEmployeeModel(EmployeeListModel* model) {
+    if (m_employeeModel == model)
+        return;
+    if (m_employeeModel)
+        disconnect(m_employeeModel, nullptr, this, nullptr);
+
+    m_employeeModel = model;
+    if (m_employeeModel) {
+        // A head's name change can change which departments match the current query
+        connect(m_employeeModel, &QAbstractItemModel::dataChanged, this,
+                &DepartmentFilterModel::sourceDataChanged);
+        connect(m_employeeModel, &QAbstractItemModel::rowsInserted, this,
+                &DepartmentFilterModel::sourceDataChanged);
+        connect(m_employeeModel, &QAbstractItemModel::rowsRemoved, this,
+                &DepartmentFilterModel::sourceDataChanged);
+        connect(m_employeeModel, &QAbstractItemModel::modelReset, this,
+                &DepartmentFilterModel::sourceDataChanged);
+    }
+    sourceDataChanged();
+    emit employeeModelChanged();
+}
+
+AsyncFilterModel::MatchJob DepartmentFilterModel::createMatchJob(const QString& query,
+                                                                 const Ranks* previous) const {
+    auto* departmentModel = qobject_cast<DepartmentListModel*>(sourceModel());
+    if (!departmentModel)
+        return []() { return Ranks(); };
+
+    // Both lists are shared with the models, not copied
+    QList<Department> departments = departmentModel->items();
+    QList<Employee> employees = m_employeeModel ? m_employeeModel->items() : QList<Employee>();
+    Ranks candidates = previous ? *previous : Ranks();
+    bool narrow = previous != nullptr;
+    return [departments, employees, query, candidates, narrow]() {
+        QSet<QString> headIds;
+        for (const Department& department : departments) {
+            if (!department.headId.isEmpty())
+                headIds.insert(department.headId);
+        }
+        QHash<QString, QString> headNames;
+        for (const Employee& employee : employees) {
+            if (headIds.contains(employee.id))
+                headNames.insert(employee.id, employee.fullName());
+        }
+
+        Ranks ranks;
+        for (const Department& department : departments) {
+            if (narrow && !candidates.contains(department.id))
+                continue;
+            if (department.name.startsWith(query, Qt::CaseInsensitive))
+                ranks.insert(department.id, 0);
+            else if (department.name.contains(query, Qt::CaseInsensitive))
+                ranks.insert(department.id, 1);
+            else if (headNames.value(department.headId).contains(query, Qt::CaseInsensitive))
+                ranks.insert(department.id, 2);
+        }
+        return ranks;
+    };
+}
+
+QString DepartmentFilterModel::idOfRow(int sourceRow) const {
+    auto* departments = qobject_cast<DepartmentListModel*>(sourceModel());
+    if (!departments || sourceRow < 0 || sourceRow >= departments->items().size())
+        return QString();
+    return departments->items().at(sourceRow).id;
+}
@@ -0,0 +1,115 @@
+#include "models/departmentlistmodel.h"
+
+#include "models/employeelistmodel.h"
+
+#include <utility>
+
+DepartmentListModel::DepartmentListModel(QObject* parent) : KeyedListModel<Department>(parent) {
+    connect(this, &QAbstractItemModel::rowsInserted, this, &DepartmentListModel::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &DepartmentListModel::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &DepartmentListModel::countChanged);
+}
+
+QHash<int, QByteArray> DepartmentListModel::roleNames() const {
+    return {{IdRole, "id"}, {NameRole, "name"}, {HeadIdRole, "headId"}, {HeadNameRole, "headName"}};
+}
+
+QString DepartmentListModel::nameOf(const QString& id) const {
+    const Department* department = itemById(id);
+    return department ? department->name : QString();
+}
+
+QStringList DepartmentListModel::idsHeadedBy(const QString& employeeId) const {
+    return m_idsByHead.values(employeeId);
+}
+
+void DepartmentListModel::setEmployeeModel(EmployeeListModel* model) {
+    if (m_employeeModel)
+        disconnect(m_employeeModel, nullptr, this, nullptr);
+    m_employeeModel = model;
+    if (model) {
+        // Only heads matter, whether they are edited, added or removed
+        auto refreshAll = [this]() { notifyAllRows(HeadNameRole); };
+        connect(model, &QAbstractItemModel::dataChanged, this,
+                &DepartmentListModel::onEmployeesChanged);
+        connect(model, &QAbstractItemModel::rowsInserted, this,
+                &DepartmentListModel::onEmployeesInserted);
+        connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+                &DepartmentListModel::onEmployeesAboutToBeRemoved);
+        connect(model, &QAbstractItemModel::rowsRemoved, this,
+                &DepartmentListModel::onEmployeesRemoved);
+        connect(model, &QAbstractItemModel::modelReset, this, refreshAll);
+    }
+    notifyAllRows(HeadNameRole);
+}
+
+void DepartmentListModel::onEmployeesChanged(const QModelIndex& topLeft,
+                                             const QModelIndex& bottomRight,
+                                             const QList<int>& roles) {
+    // Head names are all we show of employees. Ignoring the other roles also keeps the
+    // employee model's DepartmentNameRole updates from bouncing back here.
+    if (!roles.isEmpty() && !roles.contains(Qt::DisplayRole)
+        && !roles.contains(EmployeeListModel::FirstNameRole)
+        && !roles.contains(EmployeeListModel::LastNameRole)
+        && !roles.contains(EmployeeListModel::FullNameRole))
+        return;
+
+    for (int employeeRow = topLeft.row(); employeeRow <= bottomRight.row(); ++employeeRow)
+        notifyHeadedBy(m_employeeModel->items().at(employeeRow).id);
+}
+
+void DepartmentListModel::onEmployeesInserted(const QModelIndex&, int first, int last) {
+    for (int employeeRow = first; employeeRow <= last; ++employeeRow)
+        notifyHeadedBy(m_employeeModel->items().at(employeeRow).id);
+}
+
+void DepartmentListModel::onEmployeesAboutToBeRemoved(const QModelIndex&, int first, int last) {
+    for (int employeeRow = first; employeeRow <= last; ++employeeRow) {
+        const QString& employeeId = m_employeeModel->items().at(employeeRow).id;
+        if (m_idsByHead.contains(employeeId))
+            m_removedEmployeeIds.append(employeeId);
+    }
+}
+
+void DepartmentListModel::onEmployeesRemoved() {
+    const QStringList removed = std::exchange(m_removedEmployeeIds, QStringList());
+    for (const QString& employeeId : removed)
+        notifyHeadedBy(employeeId);
+}
+
+void DepartmentListModel::notifyHeadedBy(const QString& employeeId) {
+    for (const QString& deptId : m_idsByHead.values(employeeId)) {
+        QModelIndex changed = index(rowOfId(deptId));
+        emit dataChanged(changed, changed, {HeadNameRole});
+    }
+}
+
+void DepartmentListModel::notifyAllRows(int role) {
+    if (rowCount() > 0)
+        emit dataChanged(index(0), index(rowCount() - 1), {role});
+}
+
+void DepartmentListModel::itemAdded(const Department& department) {
+    if (!department.headId.isEmpty())
+        m_idsByHead.insert(department.headId, department.id);
+}
+
+void DepartmentListModel::itemRemoved(const Department& department) {
+    m_idsByHead.remove(department.headId, department.id);
+}
+
+QVariant DepartmentListModel::dataForRole(const Department& department, int role) const {
+    switch (role) {
+        case IdRole:
+            return department.id;
+        case Qt::DisplayRole:
+        case NameRole:
+            return department.name;
+        case HeadIdRole:
+            return department.headId;
+        case HeadNameRole:
+            return m_employeeModel ? m_employeeModel->fullNameOf(department.headId) : QString();
+        default:
+            return QVariant();
+    }
+}
@@ -1,5 +1,7 @@
 #include "models/employee.h"
 
+#include "models/isodatetime.h"
+
 Employee Employee::fromJson(const QJsonObject& json) {
     Employee emp;
     emp.id = json["id"].toString();
@@ -12,18 +14,10 @@ Employee Employee::fromJson(const QJsonObject& json) {
     emp.managerId = json["manager_id"].toString();
     emp.salaryGradeId = json["salary_grade_id"].toString();
 
-    if (json.contains("hire_date") && !json["hire_date"].isNull()) {
-        emp.hireDate = QDateTime::fromString(json["hire_date"].toString(), Qt::ISODate);
-    }
-    if (json.contains("created_at") && !json["created_at"].isNull()) {
-        emp.createdAt = QDateTime::fromString(json["created_at"].toString(), Qt::ISODate);
-    }
-    if (json.contains("updated_at") && !json["updated_at"].isNull()) {
-        emp.updatedAt = QDateTime::fromString(json["updated_at"].toString(), Qt::ISODate);
-    }
-    if (json.contains("deleted_at") && !json["deleted_at"].isNull()) {
-        emp.deletedAt = QDateTime::fromString(json["deleted_at"].toString(), Qt::ISODate);
-    }
+    emp.hireDate = parseIsoDateTime(json.value("hire_date"));
+    emp.createdAt = parseIsoDateTime(json.value("created_at"));
+    emp.updatedAt = parseIsoDateTime(json.value("updated_at"));
+    emp.deletedAt = parseIsoDateTime(json.value("deleted_at"));
 
     return emp;
 }
@@ -46,3 +40,12 @@ QJsonObject Employee::toJson() const {
         json["hire_date"] = hireDate.toString(Qt::ISODate);
     return json;
 }
+
+bool Employee::operator==(const Employee& other) const {
+    return id == other.id && firstName == other.firstName && lastName == other.lastName &&
+           email == other.email && role == other.role && active == other.active &&
+           departmentId == other.departmentId && managerId == other.managerId &&
+           salaryGradeId == other.salaryGradeId && hireDate == other.hireDate &&
+           createdAt == other.createdAt && updatedAt == other.updatedAt &&
+           deletedAt == other.deletedAt;
+}
@@ -0,0 +1,155 @@
+#include "models/employeecolumns.h"
+
+#include "models/compactemployee.h"
+
+void EmployeeColumns::insert(const Employee& employee) {
+    CompactId id = CompactId::fromString(employee.id);
+    const qint32 department = intern(employee.departmentId, m_departmentIndex, m_departmentIds);
+    const qint32 grade = intern(employee.salaryGradeId, m_gradeIndex, m_gradeIds);
+    const quint8 active = employee.active ? 1 : 0;
+    const qint64 hireDate = employee.hireDate.isValid() ? employee.hireDate.toMSecsSinceEpoch()
+                                                        : CompactEmployee::NoTime;
+
+    auto existing = m_rowById.constFind(id);
+    if (existing != m_rowById.cend()) {
+        const int row = *existing;
+        m_department[row] = department;
+        m_grade[row] = grade;
+        m_active[row] = active;
+        m_hireDate[row] = hireDate;
+        return;
+    }
+
+    m_rowById.insert(id, size());
+    m_ids.append(id);
+    m_department.append(department);
+    m_grade.append(grade);
+    m_active.append(active);
+    m_hireDate.append(hireDate);
+}
+
+void EmployeeColumns::remove(const QString& id) {
+    auto existing = m_rowById.find(CompactId::find(id));
+    if (existing == m_rowById.end())
+        return;
+    const int row = *existing;
+    const int last = size() - 1;
+    m_rowById.erase(existing);
+    if (row != last) {
+        m_ids[row] = m_ids.at(last);
+        m_department[row] = m_department.at(last);
+        m_grade[row] = m_grade.at(last);
+        m_active[row] = m_active.at(last);
+        m_hireDate[row] = m_hireDate.at(last);
+        m_rowById[m_ids.at(row)] = row;
+    }
+    m_ids.removeLast();
+    m_department.removeLast();
+    m_grade.removeLast();
+    m_active.removeLast();
+    m_hireDate.removeLast();
+}
+
+void EmployeeColumns::clear() {
+    m_ids.clear();
+    m_department.clear();
+    m_grade.clear();
+    m_active.clear();
+    m_hireDate.clear();
+    m_rowById.clear();
+}
+
+qint32 EmployeeColumns::departmentIndexOf(const QString& departmentId) const {
+    return m_departmentIndex.value(CompactId::find(departmentId), None);
+}
+
+qint32 EmployeeColumns::gradeIndexOf(const QString& gradeId) const {
+    return m_gradeIndex.value(CompactId::find(gradeId), None);
+}
+
+// The scans below read the columns and write their results through raw pointers, so no
+// container is detached or bounds-checked inside a loop. The counts and countHiredBetween()
+// are branch-free; only countHiredBetween() has no scatter step and can be vectorised.
+// sumByDepartment() still branches past rows without a department or a known grade.
+
+namespace {
+
+// Counts rows per group, with None counted in an extra slot in front that is dropped again,
+// so the loop needs no branch
+QList<int> countPerGroup(const qint32* group, const quint8* active, int rows, bool activeOnly,
+                         qsizetype groups) {
+    static_assert(EmployeeColumns::None == -1, "None rows go to the slot in front");
+    QList<int> counts(groups + 1, 0);
+    int* slot = counts.data() + 1;
+    if (activeOnly) {
+        for (int row = 0; row < rows; ++row)
+            slot[group[row]] += active[row];
+    } else {
+        for (int row = 0; row < rows; ++row)
+            ++slot[group[row]];
+    }
+    counts.removeFirst();
+    return counts;
+}
+
+} // namespace
+
+QList<int> EmployeeColumns::countByDepartment(bool activeOnly) const {
+    return countPerGroup(m_department.constData(), m_active.constData(), size(), activeOnly,
+                         m_departmentIds.size());
+}
+
+QList<int> EmployeeColumns::countByGrade(bool activeOnly) const {
+    return countPerGroup(m_grade.constData(), m_active.constData(), size(), activeOnly,
+                         m_gradeIds.size());
+}
+
+QList<double> EmployeeColumns::sumByDepartment(const QList<double>& valueByGrade,
+                                               bool activeOnly) const {
+    QList<double> sums(m_departmentIds.size(), 0.0);
+    double* sum = sums.data();
+    const double* value = valueByGrade.constData();
+    const qint32* department = m_department.constData();
+    const qint32* grade = m_grade.constData();
+    const quint8* active = m_active.constData();
+    const qint32 gradeCount = static_cast<qint32>(valueByGrade.size());
+    const int rows = size();
+    for (int row = 0; row < rows; ++row) {
+        const qint32 g = grade[row];
+        if (department[row] == None || g == None || g >= gradeCount)
+            continue;
+        const double weight = activeOnly ? active[row] : 1.0;
+        sum[department[row]] += value[g] * weight;
+    }
+    return sums;
+}
+
+int EmployeeColumns::countHiredBetween(qint64 fromMs, qint64 toMs, bool activeOnly) const {
+    const qint64* hireDate = m_hireDate.constData();
+    const quint8* active = m_active.constData();
+    const int rows = size();
+    int count = 0;
+    // NoTime is the smallest qint64, so unknown dates sort before any real range
+    if (activeOnly) {
+        for (int row = 0; row < rows; ++row)
+            count += int(hireDate[row] >= fromMs) & int(hireDate[row] < toMs) & active[row];
+    } else {
+        for (int row = 0; row < rows; ++row)
+            count += int(hireDate[row] >= fromMs) & int(hireDate[row] < toMs);
+    }
+    return count;
+}
+
+qint32 EmployeeColumns::intern(const QString& id, QHash<CompactId, qint32>& indices,
+                               QList<CompactId>& ids) {
+    if (id.isEmpty())
+        return None;
+    CompactId key = CompactId::fromString(id);
+    auto existing = indices.constFind(key);
+    if (existing != indices.cend())
+        return *existing;
+    const auto index = static_cast<qint32>(ids.size());
+    ids.append(key);
+    indices.insert(key, index);
+    return index;
+}
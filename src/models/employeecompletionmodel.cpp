@@ -0,0 +1,117 @@
+#include "models/employeecompletionmodel.h"
+
+EmployeeCompletionModel::EmployeeCompletionModel(QObject* parent)
+    : KeyedListModel<EmployeeCompletion>(parent) {
+    m_sourceChangedTimer.setSingleShot(true);
+    m_sourceChangedTimer.setInterval(0);
+    connect(&m_sourceChangedTimer, &QTimer::timeout, this, &EmployeeCompletionModel::update);
+
+    connect(this, &QAbstractItemModel::rowsInserted, this, &EmployeeCompletionModel::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &EmployeeCompletionModel::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &EmployeeCompletionModel::countChanged);
+}
+
+QHash<int, QByteArray> EmployeeCompletionModel::roleNames() const {
+    return {{IdRole, "id"}, {FullNameRole, "fullName"}, {RoleRole, "role"}};
+}
+
+void EmployeeCompletionModel::setEmployeeModel(EmployeeListModel* model) {
+    if (m_employeeModel == model)
+        return;
+    if (m_employeeModel)
+        disconnect(m_employeeModel, nullptr, this, nullptr);
+
+    m_employeeModel = model;
+    if (m_employeeModel) {
+        auto scheduleUpdate = [this]() {
+            if (m_active)
+                m_sourceChangedTimer.start();
+        };
+        connect(m_employeeModel, &QAbstractItemModel::dataChanged, this, scheduleUpdate);
+        connect(m_employeeModel, &QAbstractItemModel::rowsInserted, this, scheduleUpdate);
+        connect(m_employeeModel, &QAbstractItemModel::rowsRemoved, this, scheduleUpdate);
+        connect(m_employeeModel, &QAbstractItemModel::modelReset, this, scheduleUpdate);
+    }
+    update();
+    emit employeeModelChanged();
+}
+
+void EmployeeCompletionModel::setQuery(const QString& query) {
+    if (m_query == query)
+        return;
+    m_query = query;
+    update();
+    emit queryChanged();
+}
+
+void EmployeeCompletionModel::setRoleFilter(const QString& role) {
+    if (m_roleFilter == role)
+        return;
+    m_roleFilter = role;
+    update();
+    emit roleFilterChanged();
+}
+
+void EmployeeCompletionModel::setDepartmentFilter(const QString& departmentId) {
+    if (m_departmentFilter == departmentId)
+        return;
+    m_departmentFilter = departmentId;
+    update();
+    emit departmentFilterChanged();
+}
+
+void EmployeeCompletionModel::setLimit(int limit) {
+    if (m_limit == limit)
+        return;
+    m_limit = limit;
+    update();
+    emit limitChanged();
+}
+
+void EmployeeCompletionModel::setActive(bool active) {
+    if (m_active == active)
+        return;
+    m_active = active;
+    update();
+    emit activeChanged();
+}
+
+void EmployeeCompletionModel::update() {
+    m_sourceChangedTimer.stop();
+
+    QList<EmployeeCompletion> completions;
+    bool truncated = false;
+    if (m_active && m_employeeModel && m_limit > 0) {
+        // One extra match tells whether there are more than fit
+        QStringList ids =
+            m_employeeModel->complete(m_query, m_limit + 1, m_roleFilter, m_departmentFilter);
+        truncated = ids.size() > m_limit;
+        if (truncated)
+            ids.removeLast();
+
+        completions.reserve(ids.size());
+        for (const QString& id : std::as_const(ids)) {
+            const Employee* employee = m_employeeModel->itemById(id);
+            completions.append({employee->id, employee->fullName(), employee->role});
+        }
+    }
+    setItems(completions);
+
+    if (m_truncated != truncated) {
+        m_truncated = truncated;
+        emit truncatedChanged();
+    }
+}
+
+QVariant EmployeeCompletionModel::dataForRole(const EmployeeCompletion& item, int role) const {
+    switch (role) {
+        case IdRole:
+            return item.id;
+        case FullNameRole:
+            return item.fullName;
+        case RoleRole:
+            return item.role;
+        default:
+            return QVariant();
+    }
+}
@@ -0,0 +1,31 @@
+#include "models/employeefiltermodel.h"
+
+EmployeeFilterModel::EmployeeFilterModel(QObject* parent) : AsyncFilterModel(parent) {}
+
+AsyncFilterModel::MatchJob EmployeeFilterModel::createMatchJob(const QString& query,
+                                                               const Ranks* previous) const {
+    auto* employees = qobject_cast<EmployeeListModel*>(sourceModel());
+    if (!employees)
+        return []() { return Ranks(); };
+
+    // The copy shares the index's storage; edits made meanwhile detach the model's side
+    EmployeeSearchIndex index = employees->searchIndex();
+    Ranks candidates = previous ? *previous : Ranks();
+    bool narrow = previous != nullptr;
+    return [index, query, candidates, narrow]() {
+        Ranks ranks;
+        const QList<EmployeeSearchIndex::Hit> hits =
+            narrow ? index.search(query, candidates.keys()) : index.search(query);
+        ranks.reserve(hits.size());
+        for (const EmployeeSearchIndex::Hit& hit : hits)
+            ranks.insert(hit.id, hit.rank);
+        return ranks;
+    };
+}
+
+QString EmployeeFilterModel::idOfRow(int sourceRow) const {
+    auto* employees = qobject_cast<EmployeeListModel*>(sourceModel());
+    if (!employees || sourceRow < 0 || sourceRow >= employees->items().size())
+        return QString();
+    return employees->items().at(sourceRow).id;
+}
@@ -0,0 +1,208 @@
+#include "models/employeelistmodel.h"
+
+#include "models/departmentlistmodel.h"
+#include "models/salarygradelistmodel.h"
+
+EmployeeListModel::EmployeeListModel(QObject* parent) : KeyedListModel<Employee>(parent) {
+    connect(this, &QAbstractItemModel::rowsInserted, this, &EmployeeListModel::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &EmployeeListModel::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &EmployeeListModel::countChanged);
+}
+
+QHash<int, QByteArray> EmployeeListModel::roleNames() const {
+    return {{IdRole, "id"},
+            {FirstNameRole, "firstName"},
+            {LastNameRole, "lastName"},
+            {FullNameRole, "fullName"},
+            {EmailRole, "email"},
+            {RoleRole, "role"},
+            {ActiveRole, "active"},
+            {DepartmentIdRole, "departmentId"},
+            {ManagerIdRole, "managerId"},
+            {SalaryGradeIdRole, "salaryGradeId"},
+            {HireDateRole, "hireDate"},
+            {DepartmentNameRole, "departmentName"},
+            {SalaryGradeLabelRole, "salaryGradeLabel"}};
+}
+
+QString EmployeeListModel::fullNameOf(const QString& id) const {
+    const Employee* employee = itemById(id);
+    return employee ? employee->fullName() : QString();
+}
+
+QString EmployeeListModel::idOfEmail(const QString& email) const {
+    return m_idByEmail.value(email.trimmed().toLower());
+}
+
+QStringList EmployeeListModel::reportIdsOf(const QString& managerId) const {
+    return m_hierarchy.directReportsOf(managerId);
+}
+
+QStringList EmployeeListModel::allReportIdsOf(const QString& managerId) const {
+    return m_hierarchy.reportsUnder(managerId);
+}
+
+QStringList EmployeeListModel::chainOfCommandOf(const QString& id) const {
+    return m_hierarchy.chainOfCommand(id);
+}
+
+bool EmployeeListModel::wouldCreateCycle(const QString& id, const QString& managerId) const {
+    return m_hierarchy.wouldCreateCycle(id, managerId);
+}
+
+QStringList EmployeeListModel::memberIdsOf(const QString& departmentId) const {
+    return m_memberIds.values(departmentId);
+}
+
+QStringList EmployeeListModel::search(const QString& text, int limit) const {
+    QStringList ids;
+    for (const EmployeeSearchIndex::Hit& hit : m_searchIndex.search(text)) {
+        if (limit >= 0 && ids.size() >= limit)
+            break;
+        ids.append(hit.id);
+    }
+    return ids;
+}
+
+QStringList EmployeeListModel::complete(const QString& text, int limit, const QString& role,
+                                        const QString& departmentId) const {
+    std::function<bool(const QString&)> accept;
+    if (!role.isEmpty() || !departmentId.isEmpty()) {
+        accept = [this, &role, &departmentId](const QString& id) {
+            const Employee* employee = itemById(id);
+            return employee && (role.isEmpty() || employee->role == role) &&
+                   (departmentId.isEmpty() || employee->departmentId == departmentId);
+        };
+    }
+
+    QStringList ids;
+    for (const EmployeeSearchIndex::Hit& hit : m_searchIndex.topMatches(text, limit, accept))
+        ids.append(hit.id);
+    return ids;
+}
+
+void EmployeeListModel::setDepartmentModel(DepartmentListModel* model) {
+    if (m_departmentModel)
+        disconnect(m_departmentModel, nullptr, this, nullptr);
+    m_departmentModel = model;
+    if (model) {
+        // Renames only touch the members; adding or dropping departments may resolve anyone
+        connect(model, &QAbstractItemModel::dataChanged, this,
+                &EmployeeListModel::onDepartmentsChanged);
+        connect(model, &QAbstractItemModel::rowsInserted, this,
+                &EmployeeListModel::onDepartmentsReset);
+        connect(model, &QAbstractItemModel::rowsRemoved, this,
+                &EmployeeListModel::onDepartmentsReset);
+        connect(model, &QAbstractItemModel::modelReset, this,
+                &EmployeeListModel::onDepartmentsReset);
+    }
+    onDepartmentsReset();
+}
+
+void EmployeeListModel::setSalaryGradeModel(SalaryGradeListModel* model) {
+    if (m_salaryGradeModel)
+        disconnect(m_salaryGradeModel, nullptr, this, nullptr);
+    m_salaryGradeModel = model;
+    if (model) {
+        // There are only a handful of grades, so any change simply refreshes every label
+        auto refreshAll = [this]() { notifyAllRows(SalaryGradeLabelRole); };
+        connect(model, &QAbstractItemModel::dataChanged, this, refreshAll);
+        connect(model, &QAbstractItemModel::rowsInserted, this, refreshAll);
+        connect(model, &QAbstractItemModel::rowsRemoved, this, refreshAll);
+        connect(model, &QAbstractItemModel::modelReset, this, refreshAll);
+    }
+    notifyAllRows(SalaryGradeLabelRole);
+}
+
+void EmployeeListModel::onDepartmentsChanged(const QModelIndex& topLeft,
+                                             const QModelIndex& bottomRight,
+                                             const QList<int>& roles) {
+    // Members only show the department's name; HeadNameRole updates in particular are
+    // triggered from here and must not come back
+    if (!roles.isEmpty() && !roles.contains(DepartmentListModel::NameRole)
+        && !roles.contains(Qt::DisplayRole))
+        return;
+
+    for (int deptRow = topLeft.row(); deptRow <= bottomRight.row(); ++deptRow) {
+        const QString& deptId = m_departmentModel->items().at(deptRow).id;
+        for (const QString& employeeId : m_memberIds.values(deptId)) {
+            int row = rowOfId(employeeId);
+            m_searchIndex.insert(items().at(row), departmentNameOf(items().at(row)));
+            QModelIndex changed = index(row);
+            emit dataChanged(changed, changed, {DepartmentNameRole});
+        }
+    }
+}
+
+void EmployeeListModel::onDepartmentsReset() {
+    // Only entries whose department name actually changed are re-indexed
+    for (const Employee& employee : items())
+        m_searchIndex.insert(employee, departmentNameOf(employee));
+    notifyAllRows(DepartmentNameRole);
+}
+
+QString EmployeeListModel::departmentNameOf(const Employee& employee) const {
+    return m_departmentModel ? m_departmentModel->nameOf(employee.departmentId) : QString();
+}
+
+void EmployeeListModel::notifyAllRows(int role) {
+    if (rowCount() > 0)
+        emit dataChanged(index(0), index(rowCount() - 1), {role});
+}
+
+void EmployeeListModel::itemAdded(const Employee& employee) {
+    if (!employee.email.isEmpty())
+        m_idByEmail.insert(employee.email.trimmed().toLower(), employee.id);
+    m_hierarchy.setManager(employee.id, employee.managerId);
+    if (!employee.departmentId.isEmpty())
+        m_memberIds.insert(employee.departmentId, employee.id);
+    m_searchIndex.insert(employee, departmentNameOf(employee));
+    m_columns.insert(employee);
+    emit employeeAdded(employee);
+}
+
+void EmployeeListModel::itemRemoved(const Employee& employee) {
+    QString email = employee.email.trimmed().toLower();
+    if (m_idByEmail.value(email) == employee.id)
+        m_idByEmail.remove(email);
+    m_hierarchy.remove(employee.id);
+    m_memberIds.remove(employee.departmentId, employee.id);
+    m_searchIndex.remove(employee.id);
+    m_columns.remove(employee.id);
+    emit employeeRemoved(employee);
+}
+
+QVariant EmployeeListModel::dataForRole(const Employee& employee, int role) const {
+    switch (role) {
+        case IdRole:
+            return employee.id;
+        case FirstNameRole:
+            return employee.firstName;
+        case LastNameRole:
+            return employee.lastName;
+        case Qt::DisplayRole:
+        case FullNameRole:
+            return employee.fullName();
+        case EmailRole:
+            return employee.email;
+        case RoleRole:
+            return employee.role;
+        case ActiveRole:
+            return employee.active;
+        case DepartmentIdRole:
+            return employee.departmentId;
+        case ManagerIdRole:
+            return employee.managerId;
+        case SalaryGradeIdRole:
+            return employee.salaryGradeId;
+        case HireDateRole:
+            return employee.hireDate;
+        case DepartmentNameRole:
+            return departmentNameOf(employee);
+        case SalaryGradeLabelRole:
+            return m_salaryGradeModel ? m_salaryGradeModel->labelOf(employee.salaryGradeId)
+                                      : QString();
+        default:
+            return QVariant();
+    }
+}
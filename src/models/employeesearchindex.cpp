@@ -0,0 +1,243 @@
+#include "models/employeesearchindex.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Tombstones are only worth a rebuild once there is a meaningful number of them
+constexpr int MinCompactDeadCount = 1024;
+
+quint64 trigramAt(const QString& text, int pos) {
+    return (quint64(text.at(pos).unicode()) << 32) | (quint64(text.at(pos + 1).unicode()) << 16) |
+           quint64(text.at(pos + 2).unicode());
+}
+
+bool startsWord(const QString& text, const QString& query) {
+    for (int pos = text.indexOf(query); pos >= 0; pos = text.indexOf(query, pos + 1)) {
+        if (pos == 0 || !text.at(pos - 1).isLetterOrNumber())
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void EmployeeSearchIndex::insert(const Employee& employee, const QString& departmentName) {
+    Entry entry;
+    entry.id = employee.id;
+    entry.name = employee.fullName().toLower();
+    entry.email = employee.email.toLower();
+    entry.role = employee.role.toLower();
+    entry.department = departmentName.toLower();
+
+    auto existing = m_slotById.constFind(employee.id);
+    if (existing != m_slotById.cend()) {
+        const Entry& current = m_entries.at(*existing);
+        if (current.name == entry.name && current.email == entry.email &&
+            current.role == entry.role && current.department == entry.department)
+            return;
+        remove(employee.id);
+    }
+
+    int slot = static_cast<int>(m_entries.size());
+    m_entries.append(entry);
+    m_slotById.insert(entry.id, slot);
+    addTrigrams(slot, entry.name);
+    addTrigrams(slot, entry.email);
+    addTrigrams(slot, entry.role);
+    addTrigrams(slot, entry.department);
+}
+
+void EmployeeSearchIndex::remove(const QString& id) {
+    auto slot = m_slotById.find(id);
+    if (slot == m_slotById.end())
+        return;
+    m_entries[*slot].alive = false;
+    m_slotById.erase(slot);
+    ++m_deadCount;
+    if (m_deadCount >= MinCompactDeadCount && m_deadCount > m_slotById.size())
+        compact();
+}
+
+void EmployeeSearchIndex::clear() {
+    m_entries.clear();
+    m_slotById.clear();
+    m_postings.clear();
+    m_deadCount = 0;
+}
+
+QString EmployeeSearchIndex::departmentNameOf(const QString& id) const {
+    auto slot = m_slotById.constFind(id);
+    return slot != m_slotById.cend() ? m_entries.at(*slot).department : QString();
+}
+
+QList<EmployeeSearchIndex::Hit> EmployeeSearchIndex::search(const QString& text) const {
+    QList<Hit> hits;
+    const QString query = text.trimmed().toLower();
+    if (query.isEmpty())
+        return hits;
+
+    for (int slot : candidateSlots(query))
+        collect(slot, query, hits);
+    std::stable_sort(hits.begin(), hits.end(),
+                     [](const Hit& a, const Hit& b) { return a.rank < b.rank; });
+    return hits;
+}
+
+QList<EmployeeSearchIndex::Hit> EmployeeSearchIndex::search(const QString& text,
+                                                            const QStringList& candidates) const {
+    QList<Hit> hits;
+    const QString query = text.trimmed().toLower();
+    if (query.isEmpty())
+        return hits;
+
+    for (const QString& id : candidates) {
+        auto slot = m_slotById.constFind(id);
+        if (slot != m_slotById.cend())
+            collect(*slot, query, hits);
+    }
+    std::stable_sort(hits.begin(), hits.end(),
+                     [](const Hit& a, const Hit& b) { return a.rank < b.rank; });
+    return hits;
+}
+
+QList<EmployeeSearchIndex::Hit>
+EmployeeSearchIndex::topMatches(const QString& text, int limit,
+                                const std::function<bool(const QString&)>& accept) const {
+    struct Candidate {
+        int rank;
+        int slot;
+    };
+    QList<Candidate> candidates;
+    const QString query = text.trimmed().toLower();
+    auto consider = [&](int slot) {
+        const Entry& entry = m_entries.at(slot);
+        if (!entry.alive)
+            return;
+        int rank = query.isEmpty() ? 0 : rankOf(entry, query);
+        if (rank >= 0 && (!accept || accept(entry.id)))
+            candidates.append({rank, slot});
+    };
+    if (query.isEmpty()) {
+        for (int slot = 0; slot < m_entries.size(); ++slot)
+            consider(slot);
+    } else {
+        for (int slot : candidateSlots(query))
+            consider(slot);
+    }
+
+    // Only the first `limit` candidates end up in order
+    auto better = [this](const Candidate& a, const Candidate& b) {
+        if (a.rank != b.rank)
+            return a.rank < b.rank;
+        const Entry& left = m_entries.at(a.slot);
+        const Entry& right = m_entries.at(b.slot);
+        return left.name != right.name ? left.name < right.name : left.id < right.id;
+    };
+    int count = static_cast<int>(candidates.size());
+    if (limit >= 0)
+        count = std::min(count, limit);
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), better);
+
+    QList<Hit> hits;
+    hits.reserve(count);
+    for (int i = 0; i < count; ++i)
+        hits.append({m_entries.at(candidates.at(i).slot).id, candidates.at(i).rank});
+    return hits;
+}
+
+QList<int> EmployeeSearchIndex::candidateSlots(const QString& query) const {
+    QList<int> found;
+    if (query.size() < 3) {
+        // Too short for a trigram; such queries match a large share of entries anyway
+        found.reserve(m_entries.size());
+        for (int slot = 0; slot < m_entries.size(); ++slot)
+            found.append(slot);
+        return found;
+    }
+
+    QList<const QList<int>*> lists;
+    QSet<quint64> seen;
+    for (int pos = 0; pos + 2 < query.size(); ++pos) {
+        quint64 trigram = trigramAt(query, pos);
+        if (seen.contains(trigram))
+            continue;
+        seen.insert(trigram);
+        auto postings = m_postings.constFind(trigram);
+        if (postings == m_postings.cend())
+            return found;
+        lists.append(&*postings);
+    }
+
+    // Intersect starting from the rarest trigram; lists are sorted by slot
+    std::sort(lists.begin(), lists.end(),
+              [](const QList<int>* a, const QList<int>* b) { return a->size() < b->size(); });
+    for (int slot : *lists.first()) {
+        bool inAll = true;
+        for (int i = 1; i < lists.size() && inAll; ++i)
+            inAll = std::binary_search(lists.at(i)->begin(), lists.at(i)->end(), slot);
+        if (inAll)
+            found.append(slot);
+    }
+    return found;
+}
+
+void EmployeeSearchIndex::collect(int slot, const QString& query, QList<Hit>& hits) const {
+    const Entry& entry = m_entries.at(slot);
+    if (!entry.alive)
+        return;
+    int rank = rankOf(entry, query);
+    if (rank >= 0)
+        hits.append({entry.id, rank});
+}
+
+int EmployeeSearchIndex::rankOf(const Entry& entry, const QString& query) {
+    // Trigrams only narrow the candidates down; the query still has to occur as a whole
+    if (entry.name.startsWith(query))
+        return 0;
+    if (startsWord(entry.name, query))
+        return 1;
+    if (entry.name.contains(query))
+        return 2;
+    if (entry.email.startsWith(query))
+        return 3;
+    if (entry.email.contains(query))
+        return 4;
+    if (entry.role.contains(query))
+        return 5;
+    if (entry.department.contains(query))
+        return 6;
+    return -1;
+}
+
+void EmployeeSearchIndex::addTrigrams(int slot, const QString& field) {
+    for (int pos = 0; pos + 2 < field.size(); ++pos) {
+        QList<int>& postings = m_postings[trigramAt(field, pos)];
+        // Repeated trigrams within one entry would otherwise be listed twice
+        if (postings.isEmpty() || postings.last() != slot)
+            postings.append(slot);
+    }
+}
+
+void EmployeeSearchIndex::compact() {
+    QList<Entry> entries;
+    entries.reserve(m_slotById.size());
+    for (const Entry& entry : std::as_const(m_entries)) {
+        if (entry.alive)
+            entries.append(entry);
+    }
+
+    clear();
+    for (const Entry& entry : std::as_const(entries)) {
+        int slot = static_cast<int>(m_entries.size());
+        m_entries.append(entry);
+        m_slotById.insert(entry.id, slot);
+        addTrigrams(slot, entry.name);
+        addTrigrams(slot, entry.email);
+        addTrigrams(slot, entry.role);
+        addTrigrams(slot, entry.department);
+    }
+}
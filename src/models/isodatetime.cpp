@@ -0,0 +1,124 @@
+#include "models/isodatetime.h"
+
+#include <QDate>
+#include <QTime>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+bool isDigit(QChar c) {
+    return c.unicode() >= u'0' && c.unicode() <= u'9';
+}
+
+// The number `count` digits starting at `pos` spell, or -1 if one is not a digit
+int readDigits(QStringView text, qsizetype pos, int count) {
+    int value = 0;
+    for (qsizetype i = pos; i < pos + count; ++i) {
+        if (!isDigit(text[i]))
+            return -1;
+        value = value * 10 + (text[i].unicode() - u'0');
+    }
+    return value;
+}
+
+QDateTime utcDateTime(QDate date, QTime time) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    return QDateTime(date, time, QTimeZone::UTC);
+#else
+    return QDateTime(date, time, Qt::UTC);
+#endif
+}
+
+QDateTime offsetDateTime(QDate date, QTime time, int offsetSeconds) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    return QDateTime(date, time, QTimeZone::fromSecondsAheadOfUtc(offsetSeconds));
+#else
+    return QDateTime(date, time, Qt::OffsetFromUTC, offsetSeconds);
+#endif
+}
+
+// Handles the forms the server produces. Returns false for anything it is not sure about,
+// including input Qt may still accept, such as "24:00:00", a space instead of 'T', minutes
+// without seconds or a compact offset.
+bool parseFast(QStringView text, QDateTime& result) {
+    const qsizetype size = text.size();
+    if (size < 10 || text[4] != u'-' || text[7] != u'-')
+        return false;
+    const int year = readDigits(text, 0, 4);
+    const int month = readDigits(text, 5, 2);
+    const int day = readDigits(text, 8, 2);
+    if (year < 0 || month < 0 || day < 0)
+        return false;
+    const QDate date(year, month, day);
+    if (!date.isValid())
+        return false;
+    if (size == 10) {
+        result = date.startOfDay();
+        return true;
+    }
+
+    if (size < 19 || text[10] != u'T' || text[13] != u':' || text[16] != u':')
+        return false;
+    const int hour = readDigits(text, 11, 2);
+    const int minute = readDigits(text, 14, 2);
+    const int second = readDigits(text, 17, 2);
+    if (hour < 0 || minute < 0 || second < 0)
+        return false;
+
+    qsizetype pos = 19;
+    int msec = 0;
+    if (pos < size && text[pos] == u'.') {
+        const qsizetype start = ++pos;
+        int fraction = 0;
+        while (pos < size && isDigit(text[pos]) && pos - start < 9) {
+            fraction = fraction * 10 + (text[pos].unicode() - u'0');
+            ++pos;
+        }
+        const int digits = static_cast<int>(pos - start);
+        if (digits == 0 || (pos < size && isDigit(text[pos])))
+            return false;
+        // Rounded the way Qt rounds it, so both paths agree on the last millisecond
+        const double seconds = fraction / std::pow(10.0, digits);
+        msec = std::min(qRound(seconds * 1000.0), 999);
+    }
+    const QTime time(hour, minute, second, msec);
+    if (!time.isValid())
+        return false;
+
+    if (pos == size) {
+        result = QDateTime(date, time);
+        return true;
+    }
+    if (text[pos] == u'Z' && pos + 1 == size) {
+        result = utcDateTime(date, time);
+        return true;
+    }
+    const QChar sign = text[pos];
+    if ((sign != u'+' && sign != u'-') || pos + 6 != size || text[pos + 3] != u':')
+        return false;
+    const int offsetHours = readDigits(text, pos + 1, 2);
+    const int offsetMinutes = readDigits(text, pos + 4, 2);
+    if (offsetHours < 0 || offsetHours > 14 || offsetMinutes < 0 || offsetMinutes > 59)
+        return false;
+    const int offset = (offsetHours * 60 + offsetMinutes) * 60;
+    result = offsetDateTime(date, time, sign == u'-' ? -offset : offset);
+    return true;
+}
+
+} // namespace
+
+QDateTime parseIsoDateTime(QStringView text) {
+    QDateTime result;
+    if (parseFast(text, result))
+        return result;
+    return QDateTime::fromString(text.toString(), Qt::ISODate);
+}
+
+QDateTime parseIsoDateTime(const QJsonValue& value) {
+    if (!value.isString())
+        return QDateTime();
+    return parseIsoDateTime(value.toString());
+}
@@ -0,0 +1,294 @@
+#include "models/managerhierarchy.h"
+
+#include <utility>
+
+void ManagerHierarchy::setManager(const QString& employeeId, const QString& managerId) {
+    const qint32 node = ensureNode(employeeId);
+    m_present[node] = 1;
+    const qint32 parent = managerId.isEmpty() ? None : ensureNode(managerId);
+    if (m_parent.at(node) == parent)
+        return;
+    detach(node);
+    if (parent != None)
+        attach(node, parent);
+}
+
+void ManagerHierarchy::remove(const QString& employeeId) {
+    const qint32 node = nodeOf(employeeId);
+    if (node == None || !m_present.at(node))
+        return;
+    m_present[node] = 0;
+    // A placeholder has no manager of its own
+    detach(node);
+    releaseIfUnused(node);
+}
+
+void ManagerHierarchy::clear() {
+    m_ids.clear();
+    m_parent.clear();
+    m_children.clear();
+    m_childSlot.clear();
+    m_present.clear();
+    m_nodeById.clear();
+    m_freeNodes.clear();
+    m_order.clear();
+    m_enter.clear();
+    m_subtreeSize.clear();
+    m_labelsValid = true;
+    m_walkedSinceEdit = 0;
+}
+
+bool ManagerHierarchy::contains(const QString& employeeId) const {
+    const qint32 node = nodeOf(employeeId);
+    return node != None && m_present.at(node);
+}
+
+QString ManagerHierarchy::managerOf(const QString& employeeId) const {
+    const qint32 node = nodeOf(employeeId);
+    if (node == None || m_parent.at(node) == None)
+        return QString();
+    return m_ids.at(m_parent.at(node)).toString();
+}
+
+QStringList ManagerHierarchy::directReportsOf(const QString& managerId) const {
+    QStringList ids;
+    const qint32 node = nodeOf(managerId);
+    if (node == None)
+        return ids;
+    ids.reserve(m_children.at(node).size());
+    for (qint32 child : m_children.at(node))
+        ids.append(m_ids.at(child).toString());
+    return ids;
+}
+
+int ManagerHierarchy::spanOfControl(const QString& managerId) const {
+    const qint32 node = nodeOf(managerId);
+    return node == None ? 0 : static_cast<int>(m_children.at(node).size());
+}
+
+QStringList ManagerHierarchy::reportsUnder(const QString& managerId) const {
+    QStringList ids;
+    const qint32 node = nodeOf(managerId);
+    if (node == None)
+        return ids;
+    if (!labelsReady()) {
+        walkReports(node, &ids);
+        return ids;
+    }
+    const qint32 begin = m_enter.at(node) + 1;
+    const qint32 end = m_enter.at(node) + m_subtreeSize.at(node);
+    ids.reserve(end - begin);
+    for (qint32 position = begin; position < end; ++position)
+        ids.append(m_ids.at(m_order.at(position)).toString());
+    return ids;
+}
+
+int ManagerHierarchy::reportCountUnder(const QString& managerId) const {
+    const qint32 node = nodeOf(managerId);
+    if (node == None)
+        return 0;
+    if (!labelsReady())
+        return walkReports(node, nullptr);
+    return m_subtreeSize.at(node) - 1;
+}
+
+QStringList ManagerHierarchy::chainOfCommand(const QString& employeeId) const {
+    QStringList ids;
+    const qint32 node = nodeOf(employeeId);
+    if (node == None)
+        return ids;
+    // Bounded, in case the data has a cycle
+    qint32 manager = m_parent.at(node);
+    for (qsizetype steps = 0; manager != None && m_present.at(manager) && steps < m_ids.size();
+         ++steps) {
+        if (manager == node)
+            break;
+        ids.append(m_ids.at(manager).toString());
+        manager = m_parent.at(manager);
+    }
+    return ids;
+}
+
+bool ManagerHierarchy::isAbove(const QString& managerId, const QString& employeeId) const {
+    const qint32 ancestor = nodeOf(managerId);
+    const qint32 node = nodeOf(employeeId);
+    if (ancestor == None || node == None)
+        return false;
+    if (labelsReady())
+        return isAboveNode(ancestor, node);
+
+    // Bounded, in case the data has a cycle
+    qint32 manager = m_parent.at(node);
+    qsizetype steps = 0;
+    for (; manager != None && manager != node && steps < m_ids.size(); ++steps) {
+        if (manager == ancestor)
+            break;
+        manager = m_parent.at(manager);
+    }
+    m_walkedSinceEdit += steps + 1;
+    return manager == ancestor;
+}
+
+bool ManagerHierarchy::wouldCreateCycle(const QString& employeeId,
+                                        const QString& managerId) const {
+    if (managerId.isEmpty())
+        return false;
+    if (managerId == employeeId)
+        return true;
+    const qint32 node = nodeOf(employeeId);
+    qint32 manager = nodeOf(managerId);
+    if (node == None || manager == None)
+        return false;
+    // Bounded, in case the data already has a cycle
+    for (qsizetype steps = 0; manager != None && steps < m_ids.size(); ++steps) {
+        if (manager == node)
+            return true;
+        manager = m_parent.at(manager);
+    }
+    return false;
+}
+
+qint32 ManagerHierarchy::nodeOf(const QString& id) const {
+    return id.isEmpty() ? None : m_nodeById.value(CompactId::find(id), None);
+}
+
+qint32 ManagerHierarchy::ensureNode(const QString& id) {
+    const CompactId key = CompactId::fromString(id);
+    auto existing = m_nodeById.constFind(key);
+    if (existing != m_nodeById.cend())
+        return *existing;
+
+    qint32 node;
+    if (!m_freeNodes.isEmpty()) {
+        node = m_freeNodes.takeLast();
+        m_ids[node] = key;
+    } else {
+        node = static_cast<qint32>(m_ids.size());
+        m_ids.append(key);
+        m_parent.append(None);
+        m_children.append(QList<qint32>());
+        m_childSlot.append(None);
+        m_present.append(0);
+    }
+    m_nodeById.insert(key, node);
+    invalidateLabels();
+    return node;
+}
+
+void ManagerHierarchy::attach(qint32 node, qint32 parent) {
+    m_parent[node] = parent;
+    m_childSlot[node] = static_cast<qint32>(m_children.at(parent).size());
+    m_children[parent].append(node);
+    invalidateLabels();
+}
+
+void ManagerHierarchy::detach(qint32 node) {
+    const qint32 parent = m_parent.at(node);
+    if (parent == None)
+        return;
+    QList<qint32>& siblings = m_children[parent];
+    const qint32 slot = m_childSlot.at(node);
+    const qint32 moved = siblings.last();
+    siblings[slot] = moved;
+    m_childSlot[moved] = slot;
+    siblings.removeLast();
+    m_parent[node] = None;
+    m_childSlot[node] = None;
+    invalidateLabels();
+    releaseIfUnused(parent);
+}
+
+void ManagerHierarchy::releaseIfUnused(qint32 node) {
+    if (m_present.at(node) || !m_children.at(node).isEmpty() || m_parent.at(node) != None)
+        return;
+    m_nodeById.remove(m_ids.at(node));
+    m_ids[node] = CompactId();
+    m_freeNodes.append(node);
+    invalidateLabels();
+}
+
+void ManagerHierarchy::invalidateLabels() {
+    m_labelsValid = false;
+    m_walkedSinceEdit = 0;
+}
+
+bool ManagerHierarchy::labelsReady() const {
+    if (!m_labelsValid && m_walkedSinceEdit >= m_ids.size())
+        ensureLabels();
+    return m_labelsValid;
+}
+
+qint32 ManagerHierarchy::walkReports(qint32 root, QStringList* ids) const {
+    // Same order as the labels. Every node has one parent, so the only node a walk down can
+    // reach twice is `root` itself, when it sits on a cycle.
+    qint32 count = 0;
+    QList<std::pair<qint32, qsizetype>> stack;
+    stack.append({root, 0});
+    while (!stack.isEmpty()) {
+        auto& [node, next] = stack.last();
+        const QList<qint32>& children = m_children.at(node);
+        if (next < children.size()) {
+            const qint32 child = children.at(next++);
+            if (child == root)
+                continue;
+            ++count;
+            if (ids)
+                ids->append(m_ids.at(child).toString());
+            stack.append({child, 0});
+        } else {
+            stack.removeLast();
+        }
+    }
+    m_walkedSinceEdit += count + 1;
+    return count;
+}
+
+void ManagerHierarchy::ensureLabels() const {
+    if (m_labelsValid)
+        return;
+    const qsizetype count = m_ids.size();
+    m_order.clear();
+    m_order.reserve(count);
+    m_enter.fill(None, count);
+    m_subtreeSize.fill(0, count);
+
+    for (qint32 node = 0; node < count; ++node) {
+        if (m_parent.at(node) == None && !m_ids.at(node).isNull())
+            label(node);
+    }
+    // Whatever is left hangs off a cycle
+    for (qint32 node = 0; node < count; ++node) {
+        if (m_enter.at(node) == None && !m_ids.at(node).isNull())
+            label(node);
+    }
+    m_labelsValid = true;
+    m_walkedSinceEdit = 0;
+}
+
+void ManagerHierarchy::label(qint32 root) const {
+    // Iterative, since reporting chains can be deeper than the call stack allows
+    QList<std::pair<qint32, qsizetype>> stack;
+    m_enter[root] = static_cast<qint32>(m_order.size());
+    m_order.append(root);
+    stack.append({root, 0});
+    while (!stack.isEmpty()) {
+        auto& [node, next] = stack.last();
+        const QList<qint32>& children = m_children.at(node);
+        if (next < children.size()) {
+            const qint32 child = children.at(next++);
+            if (m_enter.at(child) != None)
+                continue;
+            m_enter[child] = static_cast<qint32>(m_order.size());
+            m_order.append(child);
+            stack.append({child, 0});
+        } else {
+            m_subtreeSize[node] = static_cast<qint32>(m_order.size()) - m_enter.at(node);
+            stack.removeLast();
+        }
+    }
+}
+
+bool ManagerHierarchy::isAboveNode(qint32 ancestor, qint32 node) const {
+    const qint32 enter = m_enter.at(ancestor);
+    return enter < m_enter.at(node) && m_enter.at(node) < enter + m_subtreeSize.at(ancestor);
+}
@@ -0,0 +1,67 @@
+#include "models/payrollengine.h"
+
+void PayrollEngine::addEmployee(const Employee& employee) {
+    apply(employee, 1);
+}
+
+void PayrollEngine::removeEmployee(const Employee& employee) {
+    apply(employee, -1);
+}
+
+QStringList PayrollEngine::setBaseSalary(const QString& gradeId, double baseSalary) {
+    const double delta = baseSalary - m_baseSalaries.value(gradeId);
+    m_baseSalaries.insert(gradeId, baseSalary);
+    if (delta == 0.0)
+        return QStringList();
+
+    QStringList changed;
+    const QHash<QString, int> departments = m_activeByGrade.value(gradeId);
+    for (auto it = departments.cbegin(); it != departments.cend(); ++it) {
+        m_departments[it.key()].totalSalary += delta * it.value();
+        changed.append(it.key());
+    }
+    auto grade = m_grades.find(gradeId);
+    if (grade != m_grades.end())
+        grade->totalSalary += delta * grade->headcount;
+    return changed;
+}
+
+QStringList PayrollEngine::removeGrade(const QString& gradeId) {
+    QStringList changed = setBaseSalary(gradeId, 0.0);
+    m_baseSalaries.remove(gradeId);
+    return changed;
+}
+
+void PayrollEngine::clear() {
+    m_departments.clear();
+    m_grades.clear();
+    m_baseSalaries.clear();
+    m_activeByGrade.clear();
+}
+
+void PayrollEngine::apply(const Employee& employee, int sign) {
+    if (!employee.active)
+        return;
+    const double salary = m_baseSalaries.value(employee.salaryGradeId);
+    adjust(m_departments, employee.departmentId, salary, sign);
+    adjust(m_grades, employee.salaryGradeId, salary, sign);
+
+    QHash<QString, int>& departments = m_activeByGrade[employee.salaryGradeId];
+    int& count = departments[employee.departmentId];
+    count += sign;
+    if (count == 0) {
+        departments.remove(employee.departmentId);
+        if (departments.isEmpty())
+            m_activeByGrade.remove(employee.salaryGradeId);
+    }
+}
+
+void PayrollEngine::adjust(QHash<QString, Totals>& totals, const QString& id, double salary,
+                           int sign) {
+    Totals& entry = totals[id];
+    entry.headcount += sign;
+    entry.totalSalary += sign * salary;
+    // Also drops the rounding error the running sum picked up
+    if (entry.isEmpty())
+        totals.remove(id);
+}
@@ -0,0 +1,196 @@
+#include "models/payrollmodel.h"
+
+#include "models/departmentlistmodel.h"
+#include "models/employeelistmodel.h"
+#include "models/salarygradelistmodel.h"
+
+#include <algorithm>
+
+PayrollModel::PayrollModel(QObject* parent)
+    : QAbstractListModel(parent), m_flushTimer(new QTimer(this)) {
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(0);
+    connect(m_flushTimer, &QTimer::timeout, this, &PayrollModel::flush);
+
+    connect(this, &QAbstractItemModel::rowsInserted, this, &PayrollModel::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &PayrollModel::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &PayrollModel::countChanged);
+}
+
+int PayrollModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rowIds.size());
+}
+
+QVariant PayrollModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rowIds.size())
+        return QVariant();
+    const QString& id = m_rowIds.at(index.row());
+    const PayrollEngine::Totals totals = totalsOf(id);
+    switch (role) {
+        case IdRole:
+            return id;
+        case Qt::DisplayRole:
+        case NameRole:
+            if (m_groupBy == BySalaryGrade)
+                return m_gradeCodes.value(id);
+            return m_departmentModel ? m_departmentModel->nameOf(id) : QString();
+        case HeadcountRole:
+            return totals.headcount;
+        case TotalSalaryRole:
+            return totals.totalSalary;
+        case MeanSalaryRole:
+            return totals.meanSalary();
+        default:
+            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> PayrollModel::roleNames() const {
+    return {{IdRole, "id"},
+            {NameRole, "name"},
+            {HeadcountRole, "headcount"},
+            {TotalSalaryRole, "totalSalary"},
+            {MeanSalaryRole, "meanSalary"}};
+}
+
+void PayrollModel::setGroupBy(GroupBy groupBy) {
+    if (m_groupBy == groupBy)
+        return;
+    beginResetModel();
+    m_groupBy = groupBy;
+    m_rowIds = groupBy == ByDepartment ? m_engine.departmentIds() : m_engine.gradeIds();
+    std::sort(m_rowIds.begin(), m_rowIds.end());
+    m_dirtyIds.clear();
+    endResetModel();
+    emit groupByChanged();
+}
+
+void PayrollModel::setEmployeeModel(EmployeeListModel* model) {
+    if (m_employeeModel == model)
+        return;
+    if (m_employeeModel)
+        disconnect(m_employeeModel, nullptr, this, nullptr);
+    m_employeeModel = model;
+    if (model) {
+        connect(model, &EmployeeListModel::employeeAdded, this, &PayrollModel::onEmployeeAdded);
+        connect(model, &EmployeeListModel::employeeRemoved, this,
+                &PayrollModel::onEmployeeRemoved);
+    }
+    rebuild();
+}
+
+void PayrollModel::setSalaryGradeModel(SalaryGradeListModel* model) {
+    if (m_salaryGradeModel == model)
+        return;
+    if (m_salaryGradeModel)
+        disconnect(m_salaryGradeModel, nullptr, this, nullptr);
+    m_salaryGradeModel = model;
+    if (model) {
+        connect(model, &SalaryGradeListModel::gradeAdded, this, &PayrollModel::onGradeAdded);
+        connect(model, &SalaryGradeListModel::gradeRemoved, this, &PayrollModel::onGradeRemoved);
+    }
+    rebuild();
+}
+
+void PayrollModel::setDepartmentModel(DepartmentListModel* model) {
+    if (m_departmentModel == model)
+        return;
+    if (m_departmentModel)
+        disconnect(m_departmentModel, nullptr, this, nullptr);
+    m_departmentModel = model;
+    if (model) {
+        connect(model, &QAbstractItemModel::dataChanged, this, &PayrollModel::notifyNames);
+        connect(model, &QAbstractItemModel::rowsInserted, this, &PayrollModel::notifyNames);
+        connect(model, &QAbstractItemModel::rowsRemoved, this, &PayrollModel::notifyNames);
+        connect(model, &QAbstractItemModel::modelReset, this, &PayrollModel::notifyNames);
+    }
+    notifyNames();
+}
+
+void PayrollModel::rebuild() {
+    m_engine.clear();
+    m_gradeCodes.clear();
+    if (m_salaryGradeModel) {
+        for (const SalaryGrade& grade : m_salaryGradeModel->items()) {
+            m_gradeCodes.insert(grade.id, grade.code);
+            m_engine.setBaseSalary(grade.id, grade.baseSalary);
+        }
+    }
+    if (m_employeeModel) {
+        for (const Employee& employee : m_employeeModel->items())
+            m_engine.addEmployee(employee);
+    }
+
+    beginResetModel();
+    m_rowIds = m_groupBy == ByDepartment ? m_engine.departmentIds() : m_engine.gradeIds();
+    std::sort(m_rowIds.begin(), m_rowIds.end());
+    m_dirtyIds.clear();
+    m_flushTimer->stop();
+    endResetModel();
+}
+
+void PayrollModel::onEmployeeAdded(const Employee& employee) {
+    m_engine.addEmployee(employee);
+    markDirty(ByDepartment, employee.departmentId);
+    markDirty(BySalaryGrade, employee.salaryGradeId);
+}
+
+void PayrollModel::onEmployeeRemoved(const Employee& employee) {
+    m_engine.removeEmployee(employee);
+    markDirty(ByDepartment, employee.departmentId);
+    markDirty(BySalaryGrade, employee.salaryGradeId);
+}
+
+void PayrollModel::onGradeAdded(const SalaryGrade& grade) {
+    m_gradeCodes.insert(grade.id, grade.code);
+    markDirty(ByDepartment, m_engine.setBaseSalary(grade.id, grade.baseSalary));
+    markDirty(BySalaryGrade, grade.id);
+}
+
+void PayrollModel::onGradeRemoved(const SalaryGrade& grade) {
+    m_gradeCodes.remove(grade.id);
+    markDirty(ByDepartment, m_engine.removeGrade(grade.id));
+    markDirty(BySalaryGrade, grade.id);
+}
+
+void PayrollModel::markDirty(GroupBy group, const QString& id) {
+    if (group != m_groupBy)
+        return;
+    m_dirtyIds.insert(id);
+    m_flushTimer->start();
+}
+
+void PayrollModel::markDirty(GroupBy group, const QStringList& ids) {
+    for (const QString& id : ids)
+        markDirty(group, id);
+}
+
+void PayrollModel::flush() {
+    QSet<QString> dirty;
+    dirty.swap(m_dirtyIds);
+    for (const QString& id : dirty) {
+        const int row = static_cast<int>(m_rowIds.indexOf(id));
+        const bool empty = totalsOf(id).isEmpty();
+        if (row >= 0 && empty) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_rowIds.removeAt(row);
+            endRemoveRows();
+        } else if (row >= 0) {
+            emit dataChanged(index(row), index(row));
+        } else if (!empty) {
+            const int last = static_cast<int>(m_rowIds.size());
+            beginInsertRows(QModelIndex(), last, last);
+            m_rowIds.append(id);
+            endInsertRows();
+        }
+    }
+}
+
+void PayrollModel::notifyNames() {
+    if (m_groupBy == ByDepartment && rowCount() > 0)
+        emit dataChanged(index(0), index(rowCount() - 1), {NameRole, Qt::DisplayRole});
+}
+
+PayrollEngine::Totals PayrollModel::totalsOf(const QString& id) const {
+    return m_groupBy == ByDepartment ? m_engine.departmentTotals(id) : m_engine.gradeTotals(id);
+}
@@ -0,0 +1,115 @@
+#include "models/salarydistribution.h"
+
+#include <algorithm>
+
+SalaryDistribution SalaryDistribution::of(double* values, qsizetype count) {
+    SalaryDistribution distribution;
+    if (count <= 0)
+        return distribution;
+    distribution.count = static_cast<int>(count);
+    distribution.mean = sum(values, count) / count;
+    distribution.variance = sumOfSquaredDeviations(values, count, distribution.mean) / count;
+    minMax(values, count, distribution.min, distribution.max);
+
+    static constexpr double Fractions[] = {0.1, 0.5, 0.9};
+    double results[3];
+    percentiles(values, count, Fractions, 3, results);
+    distribution.p10 = results[0];
+    distribution.p50 = results[1];
+    distribution.p90 = results[2];
+    return distribution;
+}
+
+QList<int> SalaryDistribution::histogram(const double* values, qsizetype count, double min,
+                                         double max, int bins) {
+    QList<int> counts(qMax(bins, 1), 0);
+    const int last = static_cast<int>(counts.size()) - 1;
+    // A single distinct value puts everything in the first bin
+    const double scale = max > min ? counts.size() / (max - min) : 0.0;
+    int* out = counts.data();
+    for (qsizetype i = 0; i < count; ++i) {
+        const int bin = static_cast<int>((values[i] - min) * scale);
+        ++out[bin < 0 ? 0 : (bin > last ? last : bin)];
+    }
+    return counts;
+}
+
+double SalaryDistribution::sum(const double* values, qsizetype count) {
+    double acc0 = 0.0, acc1 = 0.0, acc2 = 0.0, acc3 = 0.0;
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        acc0 += values[i];
+        acc1 += values[i + 1];
+        acc2 += values[i + 2];
+        acc3 += values[i + 3];
+    }
+    for (; i < count; ++i)
+        acc0 += values[i];
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+double SalaryDistribution::sumOfSquaredDeviations(const double* values, qsizetype count,
+                                                  double mean) {
+    // Two passes instead of E[x²] - E[x]², which loses everything to cancellation when the
+    // spread is small next to the salaries themselves
+    double acc0 = 0.0, acc1 = 0.0, acc2 = 0.0, acc3 = 0.0;
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const double d0 = values[i] - mean;
+        const double d1 = values[i + 1] - mean;
+        const double d2 = values[i + 2] - mean;
+        const double d3 = values[i + 3] - mean;
+        acc0 += d0 * d0;
+        acc1 += d1 * d1;
+        acc2 += d2 * d2;
+        acc3 += d3 * d3;
+    }
+    for (; i < count; ++i)
+        acc0 += (values[i] - mean) * (values[i] - mean);
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+void SalaryDistribution::minMax(const double* values, qsizetype count, double& min,
+                                double& max) {
+    if (count <= 0) {
+        min = max = 0.0;
+        return;
+    }
+    double lo[4] = {values[0], values[0], values[0], values[0]};
+    double hi[4] = {values[0], values[0], values[0], values[0]};
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            const double v = values[i + lane];
+            lo[lane] = v < lo[lane] ? v : lo[lane];
+            hi[lane] = v > hi[lane] ? v : hi[lane];
+        }
+    }
+    for (; i < count; ++i) {
+        lo[0] = values[i] < lo[0] ? values[i] : lo[0];
+        hi[0] = values[i] > hi[0] ? values[i] : hi[0];
+    }
+    min = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+    max = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+}
+
+void SalaryDistribution::percentiles(double* values, qsizetype count, const double* fractions,
+                                     int fractionCount, double* results) {
+    double* end = values + count;
+    double* from = values;
+    for (int i = 0; i < fractionCount; ++i) {
+        if (count <= 0) {
+            results[i] = 0.0;
+            continue;
+        }
+        const double rank = std::clamp(fractions[i], 0.0, 1.0) * (count - 1);
+        const auto below = static_cast<qsizetype>(std::floor(rank));
+        double* nth = values + below;
+        std::nth_element(from, nth, end);
+        const double weight = rank - below;
+        // Everything after nth is at least as large, so the next rank is their minimum
+        results[i] = weight > 0.0 ? *nth + weight * (*std::min_element(nth + 1, end) - *nth)
+                                  : *nth;
+        from = nth;
+    }
+}
@@ -1,5 +1,7 @@
 #include "models/salarygrade.h"
 
+#include "models/isodatetime.h"
+
 SalaryGrade SalaryGrade::fromJson(const QJsonObject& json) {
     SalaryGrade grade;
     grade.id = json["id"].toString();
@@ -7,9 +9,7 @@ SalaryGrade SalaryGrade::fromJson(const QJsonObject& json) {
     grade.baseSalary = json["base_salary"].toDouble();
     grade.description = json["description"].toString();
 
-    if (json.contains("created_at") && !json["created_at"].isNull()) {
-        grade.createdAt = QDateTime::fromString(json["created_at"].toString(), Qt::ISODate);
-    }
+    grade.createdAt = parseIsoDateTime(json.value("created_at"));
 
     return grade;
 }
@@ -23,3 +23,8 @@ QJsonObject SalaryGrade::toJson() const {
     }
     return json;
 }
+
+bool SalaryGrade::operator==(const SalaryGrade& other) const {
+    return id == other.id && code == other.code && baseSalary == other.baseSalary &&
+           description == other.description && createdAt == other.createdAt;
+}
@@ -0,0 +1,47 @@
+#include "models/salarygradelistmodel.h"
+
+SalaryGradeListModel::SalaryGradeListModel(QObject* parent) : KeyedListModel<SalaryGrade>(parent) {
+    connect(this, &QAbstractItemModel::rowsInserted, this, &SalaryGradeListModel::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &SalaryGradeListModel::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &SalaryGradeListModel::countChanged);
+}
+
+QHash<int, QByteArray> SalaryGradeListModel::roleNames() const {
+    return {{IdRole, "id"},
+            {CodeRole, "code"},
+            {BaseSalaryRole, "baseSalary"},
+            {DescriptionRole, "description"},
+            {LabelRole, "label"}};
+}
+
+QString SalaryGradeListModel::codeOf(const QString& id) const {
+    const SalaryGrade* grade = itemById(id);
+    return grade ? grade->code : QString();
+}
+
+QString SalaryGradeListModel::labelOf(const QString& id) const {
+    const SalaryGrade* grade = itemById(id);
+    return grade ? label(*grade) : QString();
+}
+
+QString SalaryGradeListModel::label(const SalaryGrade& grade) {
+    return grade.code + " - $" + QString::number(grade.baseSalary, 'f', 0);
+}
+
+QVariant SalaryGradeListModel::dataForRole(const SalaryGrade& grade, int role) const {
+    switch (role) {
+        case IdRole:
+            return grade.id;
+        case CodeRole:
+            return grade.code;
+        case BaseSalaryRole:
+            return grade.baseSalary;
+        case DescriptionRole:
+            return grade.description;
+        case Qt::DisplayRole:
+        case LabelRole:
+            return label(grade);
+        default:
+            return QVariant();
+    }
+}
@@ -0,0 +1,254 @@
+#include "models/salarystatisticsmodel.h"
+
+#include "models/departmentlistmodel.h"
+#include "models/employeelistmodel.h"
+#include "models/salarygradelistmodel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SalaryStatisticsModel::SalaryStatisticsModel(QObject* parent)
+    : QAbstractListModel(parent), m_recomputeTimer(new QTimer(this)) {
+    m_recomputeTimer->setSingleShot(true);
+    m_recomputeTimer->setInterval(0);
+    connect(m_recomputeTimer, &QTimer::timeout, this, &SalaryStatisticsModel::recompute);
+}
+
+int SalaryStatisticsModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_groups.size());
+}
+
+QVariant SalaryStatisticsModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_groups.size())
+        return QVariant();
+    const Group& group = m_groups.at(index.row());
+    const SalaryDistribution& distribution = group.distribution;
+    switch (role) {
+        case IdRole:
+            return group.id;
+        case Qt::DisplayRole:
+        case NameRole:
+            if (m_groupBy == BySalaryGrade)
+                return m_salaryGradeModel ? m_salaryGradeModel->codeOf(group.id) : QString();
+            return m_departmentModel ? m_departmentModel->nameOf(group.id) : QString();
+        case CountRole:
+            return distribution.count;
+        case MeanRole:
+            return distribution.mean;
+        case VarianceRole:
+            return distribution.variance;
+        case StdDevRole:
+            return distribution.stdDev();
+        case MinRole:
+            return distribution.min;
+        case MaxRole:
+            return distribution.max;
+        case P10Role:
+            return distribution.p10;
+        case P50Role:
+            return distribution.p50;
+        case P90Role:
+            return distribution.p90;
+        case HistogramRole: {
+            QVariantList bins;
+            for (int count : group.histogram)
+                bins.append(count);
+            return bins;
+        }
+        default:
+            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> SalaryStatisticsModel::roleNames() const {
+    return {{IdRole, "id"},         {NameRole, "name"}, {CountRole, "count"},
+            {MeanRole, "mean"},     {VarianceRole, "variance"},
+            {StdDevRole, "stdDev"}, {MinRole, "min"},   {MaxRole, "max"},
+            {P10Role, "p10"},       {P50Role, "p50"},   {P90Role, "p90"},
+            {HistogramRole, "histogram"}};
+}
+
+void SalaryStatisticsModel::setGroupBy(GroupBy groupBy) {
+    if (m_groupBy == groupBy)
+        return;
+    m_groupBy = groupBy;
+    recompute();
+    emit groupByChanged();
+}
+
+void SalaryStatisticsModel::setBinCount(int bins) {
+    bins = qMax(1, bins);
+    if (m_binCount == bins)
+        return;
+    m_binCount = bins;
+    recompute();
+    emit binCountChanged();
+}
+
+QVariantMap SalaryStatisticsModel::organization() const {
+    return toMap(m_organization, m_organizationHistogram);
+}
+
+void SalaryStatisticsModel::setWhatIfSalary(const QString& gradeId, double baseSalary) {
+    if (gradeId.isEmpty() || !std::isfinite(baseSalary))
+        return;
+    auto existing = m_whatIfSalaries.constFind(gradeId);
+    if (existing != m_whatIfSalaries.constEnd() && *existing == baseSalary)
+        return;
+    m_whatIfSalaries.insert(gradeId, baseSalary);
+    // Runs now rather than on the timer, so a preview follows every keystroke
+    recompute();
+}
+
+void SalaryStatisticsModel::clearWhatIf() {
+    if (m_whatIfSalaries.isEmpty())
+        return;
+    m_whatIfSalaries.clear();
+    recompute();
+}
+
+void SalaryStatisticsModel::setEmployeeModel(EmployeeListModel* model) {
+    if (m_employeeModel == model)
+        return;
+    if (m_employeeModel)
+        disconnect(m_employeeModel, nullptr, this, nullptr);
+    m_employeeModel = model;
+    if (model) {
+        connect(model, &EmployeeListModel::employeeAdded, this,
+                &SalaryStatisticsModel::scheduleRecompute);
+        connect(model, &EmployeeListModel::employeeRemoved, this,
+                &SalaryStatisticsModel::scheduleRecompute);
+    }
+    scheduleRecompute();
+}
+
+void SalaryStatisticsModel::setSalaryGradeModel(SalaryGradeListModel* model) {
+    if (m_salaryGradeModel == model)
+        return;
+    if (m_salaryGradeModel)
+        disconnect(m_salaryGradeModel, nullptr, this, nullptr);
+    m_salaryGradeModel = model;
+    if (model) {
+        connect(model, &SalaryGradeListModel::gradeAdded, this,
+                &SalaryStatisticsModel::scheduleRecompute);
+        connect(model, &SalaryGradeListModel::gradeRemoved, this,
+                &SalaryStatisticsModel::scheduleRecompute);
+    }
+    scheduleRecompute();
+}
+
+void SalaryStatisticsModel::setDepartmentModel(DepartmentListModel* model) {
+    if (m_departmentModel == model)
+        return;
+    if (m_departmentModel)
+        disconnect(m_departmentModel, nullptr, this, nullptr);
+    m_departmentModel = model;
+    if (model) {
+        // Only the names can change; the next recompute picks them up
+        connect(model, &QAbstractItemModel::dataChanged, this,
+                &SalaryStatisticsModel::scheduleRecompute);
+        connect(model, &QAbstractItemModel::modelReset, this,
+                &SalaryStatisticsModel::scheduleRecompute);
+    }
+    scheduleRecompute();
+}
+
+void SalaryStatisticsModel::scheduleRecompute() {
+    m_recomputeTimer->start();
+}
+
+void SalaryStatisticsModel::recompute() {
+    m_recomputeTimer->stop();
+
+    static const EmployeeColumns noEmployees;
+    const EmployeeColumns& columns = m_employeeModel ? m_employeeModel->columns() : noEmployees;
+
+    // Salary per grade index; NaN for grades that are not (or no longer) known
+    QList<double> salaryByGrade(columns.gradeIds().size(),
+                                std::numeric_limits<double>::quiet_NaN());
+    if (m_salaryGradeModel) {
+        for (const SalaryGrade& grade : m_salaryGradeModel->items()) {
+            const qint32 index = columns.gradeIndexOf(grade.id);
+            if (index >= 0)
+                salaryByGrade[index] = m_whatIfSalaries.value(grade.id, grade.baseSalary);
+        }
+    }
+
+    const QList<qint32>& groupColumn =
+        m_groupBy == ByDepartment ? columns.departmentColumn() : columns.gradeColumn();
+    const QList<CompactId>& groupIds =
+        m_groupBy == ByDepartment ? columns.departmentIds() : columns.gradeIds();
+    const QList<qint32>& gradeColumn = columns.gradeColumn();
+    const QList<quint8>& activeColumn = columns.activeColumn();
+    const int rows = columns.size();
+
+    // Counting sort of the salaries by group, so every group is one contiguous slice.
+    // Slot 0 collects the employees without a group; they only count for the organization.
+    QList<qsizetype> offsets(groupIds.size() + 2, 0);
+    for (int row = 0; row < rows; ++row) {
+        const qint32 grade = gradeColumn.at(row);
+        if (activeColumn.at(row) && grade >= 0 && !std::isnan(salaryByGrade.at(grade)))
+            ++offsets[groupColumn.at(row) + 2];
+    }
+    for (qsizetype slot = 1; slot < offsets.size(); ++slot)
+        offsets[slot] += offsets[slot - 1];
+    m_values.resize(offsets.last());
+    for (int row = 0; row < rows; ++row) {
+        const qint32 grade = gradeColumn.at(row);
+        if (activeColumn.at(row) && grade >= 0 && !std::isnan(salaryByGrade.at(grade)))
+            m_values[offsets[groupColumn.at(row) + 1]++] = salaryByGrade.at(grade);
+    }
+    // offsets[slot] is now where slot ends, i.e. where slot + 1 starts
+
+    m_organizationValues = m_values;
+    m_organization =
+        SalaryDistribution::of(m_organizationValues.data(), m_organizationValues.size());
+    m_organizationHistogram = SalaryDistribution::histogram(
+        m_values.constData(), m_values.size(), m_organization.min, m_organization.max,
+        m_binCount);
+
+    QList<Group> groups;
+    for (qsizetype index = 0; index < groupIds.size(); ++index) {
+        const qsizetype begin = offsets[index];
+        const qsizetype count = offsets[index + 1] - begin;
+        if (count == 0)
+            continue;
+        Group group;
+        group.id = groupIds.at(index).toString();
+        group.histogram =
+            SalaryDistribution::histogram(m_values.constData() + begin, count,
+                                          m_organization.min, m_organization.max, m_binCount);
+        group.distribution = SalaryDistribution::of(m_values.data() + begin, count);
+        groups.append(group);
+    }
+    std::sort(groups.begin(), groups.end(),
+              [](const Group& a, const Group& b) { return a.id < b.id; });
+
+    const bool sameRows = std::equal(groups.cbegin(), groups.cend(), m_groups.cbegin(),
+                                     m_groups.cend(), [](const Group& a, const Group& b) {
+                                         return a.id == b.id;
+                                     });
+    if (sameRows) {
+        m_groups = groups;
+        if (!m_groups.isEmpty())
+            emit dataChanged(index(0), index(rowCount() - 1));
+    } else {
+        beginResetModel();
+        m_groups = groups;
+        endResetModel();
+    }
+    emit statisticsChanged();
+}
+
+QVariantMap SalaryStatisticsModel::toMap(const SalaryDistribution& distribution,
+                                         const QList<int>& histogram) {
+    QVariantList bins;
+    for (int count : histogram)
+        bins.append(count);
+    return {{"count", distribution.count}, {"mean", distribution.mean},
+            {"variance", distribution.variance}, {"stdDev", distribution.stdDev()},
+            {"min", distribution.min}, {"max", distribution.max},
+            {"p10", distribution.p10}, {"p50", distribution.p50},
+            {"p90", distribution.p90}, {"histogram", bins}};
+}
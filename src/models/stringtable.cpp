@@ -0,0 +1,52 @@
+#include "models/stringtable.h"
+
+StringTable::StringTable() {
+    m_strings.append(QString());
+    m_indices.insert(QString(), 0);
+}
+
+StringTable& StringTable::roles() {
+    static StringTable table;
+    return table;
+}
+
+StringTable& StringTable::ids() {
+    static StringTable table;
+    return table;
+}
+
+quint32 StringTable::intern(const QString& text) {
+    if (text.isEmpty())
+        return 0;
+    {
+        QReadLocker locker(&m_lock);
+        auto it = m_indices.constFind(text);
+        if (it != m_indices.constEnd())
+            return it.value();
+    }
+    QWriteLocker locker(&m_lock);
+    // Another thread may have added it between the two locks
+    auto it = m_indices.constFind(text);
+    if (it != m_indices.constEnd())
+        return it.value();
+    auto index = static_cast<quint32>(m_strings.size());
+    m_strings.append(text);
+    m_indices.insert(text, index);
+    return index;
+}
+
+qint64 StringTable::indexOf(const QString& text) const {
+    QReadLocker locker(&m_lock);
+    auto it = m_indices.constFind(text);
+    return it != m_indices.constEnd() ? qint64(it.value()) : -1;
+}
+
+QString StringTable::at(quint32 index) const {
+    QReadLocker locker(&m_lock);
+    return index < static_cast<quint32>(m_strings.size()) ? m_strings.at(index) : QString();
+}
+
+int StringTable::size() const {
+    QReadLocker locker(&m_lock);
+    return static_cast<int>(m_strings.size());
+}
@@ -0,0 +1,88 @@
+#ifndef FAKEAPISERVER_H
+#define FAKEAPISERVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QPair>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <functional>
+#include <memory>
+
+struct FakeRequest {
+    QByteArray method;
+    QByteArray path;
+    QHash<QByteArray, QByteArray> headers; // Names lower-cased
+    QByteArray body;
+};
+
+struct FakeResponse {
+    int status = 200;
+    QList<QPair<QByteArray, QByteArray>> headers;
+    QByteArray body;
+};
+
+// Minimal HTTP/1.1 server on localhost for driving ApiClient in tests. Each request is
+// answered by the handler and the connection is closed afterwards.
+class FakeApiServer {
+public:
+    using Handler = std::function<FakeResponse(const FakeRequest&)>;
+
+    explicit FakeApiServer(Handler handler) : m_handler(std::move(handler)) {
+        m_server.listen(QHostAddress::LocalHost);
+        QObject::connect(&m_server, &QTcpServer::newConnection, &m_server, [this]() {
+            while (QTcpSocket* socket = m_server.nextPendingConnection())
+                serve(socket);
+        });
+    }
+
+    QString apiUrl() const { return QString("http://127.0.0.1:%1").arg(m_server.serverPort()); }
+    const QList<FakeRequest>& requests() const { return m_requests; }
+
+private:
+    void serve(QTcpSocket* socket) {
+        auto buffer = std::make_shared<QByteArray>();
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() {
+            buffer->append(socket->readAll());
+            int headerEnd = buffer->indexOf("\r\n\r\n");
+            if (headerEnd < 0)
+                return;
+
+            FakeRequest request;
+            QList<QByteArray> lines = buffer->left(headerEnd).split('\n');
+            QList<QByteArray> requestLine = lines.takeFirst().trimmed().split(' ');
+            request.method = requestLine.value(0);
+            request.path = requestLine.value(1);
+            for (const QByteArray& line : lines) {
+                int colon = line.indexOf(':');
+                if (colon > 0)
+                    request.headers.insert(line.left(colon).trimmed().toLower(),
+                                           line.mid(colon + 1).trimmed());
+            }
+            int contentLength = request.headers.value("content-length").toInt();
+            if (buffer->size() < headerEnd + 4 + contentLength)
+                return;
+            request.body = buffer->mid(headerEnd + 4, contentLength);
+            m_requests.append(request);
+
+            FakeResponse response = m_handler(request);
+            QByteArray out = "HTTP/1.1 " + QByteArray::number(response.status) + " Fake\r\n";
+            for (const auto& header : response.headers)
+                out += header.first + ": " + header.second + "\r\n";
+            out += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+            out += "Connection: close\r\n\r\n" + response.body;
+            socket->write(out);
+            socket->disconnectFromHost();
+        });
+    }
+
+    Handler m_handler;
+    QTcpServer m_server;
+    QList<FakeRequest> m_requests;
+};
+
+#endif // FAKEAPISERVER_H
@@ -0,0 +1,463 @@
+#include "api/apiclient.h"
+#include "fakeapiserver.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+// ============================================================================
+// Request Coalescing Tests
+// ============================================================================
+
+TEST(ApiClientTest, SharesIdenticalInFlightGets) {
+    ApiClient client;
+    QSignalSpy statsSpy(&client, &ApiClient::requestStatsChanged);
+
+    client.getDepartments();
+    client.getDepartments();
+    client.getEmployees();
+    client.getEmployees(true);
+
+    EXPECT_EQ(client.coalescedRequests(), 1);
+    EXPECT_EQ(statsSpy.count(), 1);
+}
+
+TEST(ApiClientTest, MergesRefreshesRequestedWithinWindow) {
+    ApiClient client;
+
+    client.requestRefresh(ApiClient::Employees);
+    client.requestRefresh(ApiClient::Employees);
+    client.requestRefresh(ApiClient::Departments);
+    client.requestRefresh(ApiClient::Employees);
+
+    EXPECT_EQ(client.mergedRefreshes(), 2);
+    EXPECT_EQ(client.coalescedRequests(), 0);
+}
+
+// ============================================================================
+// Conditional Request Tests
+// ============================================================================
+
+TEST(ApiClientTest, AnswersUnchangedListFromValidators) {
+    FakeApiServer server([](const FakeRequest& request) {
+        FakeResponse response;
+        if (request.headers.value("if-none-match") == "\"v1\"") {
+            response.status = 304;
+            return response;
+        }
+        response.headers = {{"ETag", "\"v1\""}};
+        response.body = R"([{"id": "dept-1", "name": "Engineering"}])";
+        return response;
+    });
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy receivedSpy(&client, &ApiClient::departmentsReceived);
+    QSignalSpy notModifiedSpy(&client, &ApiClient::notModified);
+
+    client.getDepartments();
+    ASSERT_TRUE(receivedSpy.wait(5000));
+    client.getDepartments();
+    ASSERT_TRUE(notModifiedSpy.wait(5000));
+
+    EXPECT_EQ(receivedSpy.count(), 1);
+    EXPECT_EQ(notModifiedSpy.at(0).at(0).value<ApiClient::Collection>(), ApiClient::Departments);
+    EXPECT_EQ(client.cacheMisses(), 1);
+    EXPECT_EQ(client.cacheHits(), 1);
+}
+
+TEST(ApiClientTest, RevalidatesOnlyTheUrlThatWasDelivered) {
+    FakeApiServer server([](const FakeRequest&) {
+        FakeResponse response;
+        response.headers = {{"Last-Modified", "Mon, 01 Jan 2024 00:00:00 GMT"}};
+        response.body = "[]";
+        return response;
+    });
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy receivedSpy(&client, &ApiClient::employeesReceived);
+
+    client.getEmployees(false);
+    ASSERT_TRUE(receivedSpy.wait(5000));
+    client.getEmployees(true);
+    ASSERT_TRUE(receivedSpy.wait(5000));
+
+    ASSERT_EQ(server.requests().size(), 2);
+    EXPECT_FALSE(server.requests().at(1).headers.contains("if-modified-since"));
+    EXPECT_EQ(client.cacheHits(), 0);
+}
+
+TEST(ApiClientTest, ForgetsValidatorsOfUnparsableList) {
+    FakeApiServer server([](const FakeRequest&) {
+        FakeResponse response;
+        response.headers = {{"ETag", "\"v1\""}};
+        response.body = R"([{"id": "dept-1", "name": )";
+        return response;
+    });
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy errorSpy(&client, &ApiClient::errorOccurred);
+    QSignalSpy receivedSpy(&client, &ApiClient::departmentsReceived);
+
+    client.getDepartments();
+    ASSERT_TRUE(errorSpy.wait(5000));
+    client.getDepartments();
+    ASSERT_TRUE(QTest::qWaitFor([&]() { return errorSpy.count() == 2; }, 5000));
+
+    EXPECT_EQ(receivedSpy.count(), 0);
+    ASSERT_EQ(server.requests().size(), 2);
+    EXPECT_FALSE(server.requests().at(1).headers.contains("if-none-match"));
+}
+
+// ============================================================================
+// Streamed Decoding Tests
+// ============================================================================
+
+TEST(ApiClientTest, DeliversStreamedBatchesInOrder) {
+    QJsonArray employees;
+    for (int i = 0; i < 5000; ++i)
+        employees.append(QJsonObject{{"id", QString("emp-%1").arg(i)}, {"first_name", "Jo"}});
+    FakeApiServer server([employees](const FakeRequest&) {
+        FakeResponse response;
+        response.body = QJsonDocument(employees).toJson();
+        return response;
+    });
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy batchSpy(&client, &ApiClient::employeesBatchReceived);
+    QSignalSpy receivedSpy(&client, &ApiClient::employeesReceived);
+
+    client.getEmployees(false);
+    ASSERT_TRUE(receivedSpy.wait(5000));
+
+    QStringList streamed;
+    for (int i = 0; i < batchSpy.count(); ++i) {
+        for (const Employee& employee : batchSpy.at(i).at(0).value<QList<Employee>>())
+            streamed.append(employee.id);
+    }
+    QStringList received;
+    for (const Employee& employee : receivedSpy.at(0).at(0).value<QList<Employee>>())
+        received.append(employee.id);
+
+    ASSERT_EQ(received.size(), 5000);
+    EXPECT_EQ(received.first(), "emp-0");
+    EXPECT_EQ(received.last(), "emp-4999");
+    EXPECT_EQ(streamed, received);
+}
+
+TEST(ApiClientTest, ReportsBrokenElementInStream) {
+    FakeApiServer server([](const FakeRequest&) {
+        FakeResponse response;
+        response.body = R"([{"id": "emp-1"}, {"id": emp-2}])";
+        return response;
+    });
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy errorSpy(&client, &ApiClient::errorOccurred);
+    QSignalSpy receivedSpy(&client, &ApiClient::employeesReceived);
+
+    client.getEmployees(false);
+    ASSERT_TRUE(errorSpy.wait(5000));
+
+    EXPECT_TRUE(errorSpy.at(0).at(0).toString().startsWith("Malformed employee list"));
+    EXPECT_EQ(receivedSpy.count(), 0);
+}
+
+// ============================================================================
+// Batch Mutation Tests
+// ============================================================================
+
+namespace {
+
+// Answers mutations with the request body as the stored entity, failing those on `failingId`
+FakeApiServer::Handler echoEntities(const QByteArray& failingId = QByteArray()) {
+    return [failingId](const FakeRequest& request) {
+        FakeResponse response;
+        QByteArray id = request.path.mid(request.path.lastIndexOf('/') + 1);
+        if (id == failingId) {
+            response.status = 500;
+            return response;
+        }
+        QJsonObject entity = QJsonDocument::fromJson(request.body).object();
+        entity["id"] = QString::fromUtf8(id);
+        response.body = QJsonDocument(entity).toJson();
+        return response;
+    };
+}
+
+} // namespace
+
+TEST(ApiClientTest, ReportsBatchResultOnce) {
+    FakeApiServer server(echoEntities());
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy batchSpy(&client, &ApiClient::batchFinished);
+    QSignalSpy completedSpy(&client, &ApiClient::operationCompleted);
+    QSignalSpy savedSpy(&client, &ApiClient::employeeSaved);
+
+    int batchId = client.submitBatch(
+        {{"PUT", ApiClient::Departments, "dept-1", QJsonObject{{"name", "Ops"}}, {}},
+         {"PUT", ApiClient::Employees, "emp-1", QJsonObject{{"role", "Employee"}}, {}},
+         {"PUT", ApiClient::Employees, "emp-2", QJsonObject{{"role", "DepartmentHead"}}, {}}});
+    ASSERT_TRUE(batchSpy.wait(5000));
+
+    EXPECT_EQ(batchSpy.at(0).at(0).toInt(), batchId);
+    EXPECT_TRUE(batchSpy.at(0).at(1).toBool());
+    EXPECT_EQ(completedSpy.count(), 1);
+    EXPECT_EQ(savedSpy.count(), 2);
+    EXPECT_EQ(server.requests().size(), 3);
+}
+
+TEST(ApiClientTest, RollsBackBatchOnPartialFailure) {
+    FakeApiServer server(echoEntities("emp-2"));
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy batchSpy(&client, &ApiClient::batchFinished);
+    QSignalSpy completedSpy(&client, &ApiClient::operationCompleted);
+
+    QJsonObject departmentUndo{{"name", "Engineering"}};
+    QJsonObject employeeUndo{{"role", "DepartmentHead"}};
+    client.submitBatch(
+        {{"PUT", ApiClient::Departments, "dept-1", QJsonObject{{"name", "Ops"}}, departmentUndo},
+         {"PUT", ApiClient::Employees, "emp-1", QJsonObject{{"role", "Employee"}}, employeeUndo},
+         {"PUT", ApiClient::Employees, "emp-2", QJsonObject{{"role", "DepartmentHead"}}, {}}});
+    ASSERT_TRUE(batchSpy.wait(5000));
+
+    EXPECT_FALSE(batchSpy.at(0).at(1).toBool());
+    EXPECT_TRUE(batchSpy.at(0).at(2).toString().contains("rolled back"));
+    ASSERT_EQ(completedSpy.count(), 1);
+    EXPECT_FALSE(completedSpy.at(0).at(0).toBool());
+
+    // The two confirmed steps were compensated with their undo bodies
+    ASSERT_EQ(server.requests().size(), 5);
+    QList<QJsonObject> compensations;
+    for (int i = 3; i < 5; ++i)
+        compensations.append(QJsonDocument::fromJson(server.requests().at(i).body).object());
+    EXPECT_TRUE(compensations.contains(departmentUndo));
+    EXPECT_TRUE(compensations.contains(employeeUndo));
+}
+
+TEST(ApiClientTest, RollbackClearsHeadThatWasAdded) {
+    FakeApiServer server(echoEntities("emp-1"));
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy batchSpy(&client, &ApiClient::batchFinished);
+
+    // The department had no head before the batch gave it one
+    QJsonObject departmentUndo = Department("dept-1", "Engineering").toRestoreJson();
+    client.submitBatch(
+        {{"PUT", ApiClient::Departments, "dept-1", QJsonObject{{"head_id", "emp-1"}},
+          departmentUndo},
+         {"PUT", ApiClient::Employees, "emp-1", QJsonObject{{"role", "DepartmentHead"}}, {}}});
+    ASSERT_TRUE(batchSpy.wait(5000));
+
+    EXPECT_FALSE(batchSpy.at(0).at(1).toBool());
+    ASSERT_EQ(server.requests().size(), 3);
+    const FakeRequest& compensation = server.requests().at(2);
+    EXPECT_TRUE(compensation.path.endsWith("/dept-1"));
+    QJsonObject body = QJsonDocument::fromJson(compensation.body).object();
+    ASSERT_TRUE(body.contains("head_id"));
+    EXPECT_TRUE(body["head_id"].isNull());
+}
+
+// ============================================================================
+// Scheduling Tests
+// ============================================================================
+
+TEST(ApiClientTest, RetriesThrottledRequestAfterRetryAfter) {
+    auto answered = std::make_shared<int>(0);
+    FakeApiServer server([answered](const FakeRequest&) {
+        FakeResponse response;
+        if ((*answered)++ == 0) {
+            response.status = 429;
+            response.headers = {{"Retry-After", "1"}};
+            return response;
+        }
+        response.body = R"([{"id": "dept-1", "name": "Engineering"}])";
+        return response;
+    });
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    RequestScheduler* scheduler = client.scheduler();
+    QSignalSpy receivedSpy(&client, &ApiClient::departmentsReceived);
+    QSignalSpy errorSpy(&client, &ApiClient::errorOccurred);
+
+    client.getDepartments();
+    ASSERT_TRUE(QTest::qWaitFor([scheduler]() { return scheduler->throttled(); }, 5000));
+    EXPECT_EQ(scheduler->queueDepth(), 1);
+    EXPECT_LT(scheduler->concurrencyLimit(), RequestScheduler::MaxConcurrency);
+
+    ASSERT_TRUE(receivedSpy.wait(5000));
+    EXPECT_EQ(server.requests().size(), 2);
+    EXPECT_EQ(scheduler->retries(), 1);
+    EXPECT_EQ(scheduler->throttledResponses(), 1);
+    EXPECT_EQ(errorSpy.count(), 0);
+}
+
+TEST(ApiClientTest, DoesNotRetryFailedCreate) {
+    FakeApiServer server([](const FakeRequest&) {
+        FakeResponse response;
+        response.status = 503;
+        return response;
+    });
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy completedSpy(&client, &ApiClient::operationCompleted);
+
+    client.createDepartment("Research");
+    ASSERT_TRUE(completedSpy.wait(5000));
+
+    // The server may have stored it before failing, so a second POST could duplicate it
+    EXPECT_FALSE(completedSpy.at(0).at(0).toBool());
+    EXPECT_EQ(server.requests().size(), 1);
+    EXPECT_EQ(client.scheduler()->retries(), 0);
+}
+
+TEST(ApiClientTest, DispatchesByPriorityClass) {
+    FakeApiServer server([](const FakeRequest&) { return FakeResponse(); });
+    QNetworkAccessManager manager;
+    RequestScheduler scheduler(&manager);
+    auto submit = [&](const QString& path, RequestScheduler::Priority priority) {
+        scheduler.submit(QNetworkRequest(QUrl(server.apiUrl() + path)), "GET", priority);
+    };
+
+    for (int i = 0; i < RequestScheduler::MaxConcurrency; ++i)
+        submit("/background", RequestScheduler::Background);
+    submit("/bulk", RequestScheduler::Bulk);
+    // Background work stops one short of the cap, so this one still goes straight out
+    submit("/interactive-1", RequestScheduler::Interactive);
+    submit("/interactive-2", RequestScheduler::Interactive);
+
+    EXPECT_EQ(scheduler.inFlight(), RequestScheduler::MaxConcurrency);
+    EXPECT_EQ(scheduler.queueDepth(RequestScheduler::Interactive), 1);
+    EXPECT_EQ(scheduler.queueDepth(RequestScheduler::Background), 1);
+    EXPECT_EQ(scheduler.queueDepth(RequestScheduler::Bulk), 1);
+
+    ASSERT_TRUE(QTest::qWaitFor([&server]() { return server.requests().size() == 9; }, 5000));
+    // The first slot to free up goes to the interactive request, the bulk one comes last
+    EXPECT_EQ(server.requests().at(RequestScheduler::MaxConcurrency).path, "/interactive-2");
+    EXPECT_EQ(server.requests().last().path, "/bulk");
+}
+
+// ============================================================================
+// Local Validation Tests
+// ============================================================================
+
+namespace {
+
+// Lists one department, grade and employee, plus an inactive employee when asked for them;
+// mutations are echoed back as stored
+FakeApiServer::Handler directoryApi() {
+    return [](const FakeRequest& request) {
+        if (request.method != "GET")
+            return echoEntities()(request);
+        FakeResponse response;
+        if (request.path.contains("departments"))
+            response.body = R"([{"id": "dept-1", "name": "Engineering"}])";
+        else if (request.path.contains("salary-grades"))
+            response.body = R"([{"id": "grade-1", "code": "E1", "base_salary": 1}])";
+        else if (request.path.contains("include_inactive=true"))
+            response.body = R"([{"id": "emp-1", "first_name": "Ada", "last_name": "Lovelace",
+                                 "email": "ada@example.com"},
+                                {"id": "emp-2", "first_name": "Charles", "last_name": "Babbage",
+                                 "email": "charles@example.com", "active": false}])";
+        else
+            response.body = R"([{"id": "emp-1", "first_name": "Ada", "last_name": "Lovelace",
+                                 "email": "ada@example.com"}])";
+        return response;
+    };
+}
+
+int mutationCount(const FakeApiServer& server) {
+    int count = 0;
+    for (const FakeRequest& request : server.requests())
+        count += request.method != "GET" ? 1 : 0;
+    return count;
+}
+
+} // namespace
+
+TEST(ApiClientTest, RejectsInvalidEmployeeMutationsLocally) {
+    FakeApiServer server(directoryApi());
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy departmentsSpy(&client, &ApiClient::departmentsReceived);
+    QSignalSpy gradesSpy(&client, &ApiClient::salaryGradesReceived);
+    QSignalSpy employeesSpy(&client, &ApiClient::employeesReceived);
+    client.getDepartments();
+    client.getSalaryGrades();
+    client.getEmployees(true);
+    ASSERT_TRUE(QTest::qWaitFor(
+        [&]() { return departmentsSpy.count() && gradesSpy.count() && employeesSpy.count(); },
+        5000));
+
+    QSignalSpy completedSpy(&client, &ApiClient::operationCompleted);
+    client.createEmployee("Ada", "Clone", " ADA@example.com");
+    client.updateEmployee("emp-1", QJsonObject{{"department_id", "dept-9"}});
+    client.updateEmployee("emp-1", QJsonObject{{"manager_id", "emp-9"}});
+    ASSERT_TRUE(QTest::qWaitFor([&]() { return completedSpy.count() == 3; }, 5000));
+    for (int i = 0; i < 3; ++i)
+        EXPECT_FALSE(completedSpy.at(i).at(0).toBool());
+    EXPECT_TRUE(completedSpy.at(0).at(1).toString().contains("ada@example.com"));
+    EXPECT_EQ(client.avoidedRoundTrips(), 3);
+    EXPECT_EQ(mutationCount(server), 0);
+
+    // Keeping one's own email, clearing a reference and known ids all go through
+    client.updateEmployee("emp-1", QJsonObject{{"email", "ada@example.com"},
+                                               {"department_id", "dept-1"},
+                                               {"manager_id", QJsonValue::Null}});
+    client.createEmployee("Grace", "Hopper", "grace@example.com", "Employee", "dept-1", "emp-1",
+                          "grade-1");
+    ASSERT_TRUE(QTest::qWaitFor([&]() { return completedSpy.count() == 5; }, 5000));
+    EXPECT_TRUE(completedSpy.at(3).at(0).toBool());
+    EXPECT_TRUE(completedSpy.at(4).at(0).toBool());
+    EXPECT_EQ(mutationCount(server), 2);
+    EXPECT_EQ(client.avoidedRoundTrips(), 3);
+}
+
+TEST(ApiClientTest, ChecksOnlyWhatTheClientHasSeen) {
+    FakeApiServer server(directoryApi());
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy completedSpy(&client, &ApiClient::operationCompleted);
+
+    // Nothing listed yet, so the server decides
+    client.createEmployee("Grace", "Hopper", "grace@example.com", QString(), "dept-9");
+    ASSERT_TRUE(completedSpy.wait(5000));
+    EXPECT_TRUE(completedSpy.at(0).at(0).toBool());
+
+    // The stored employee the server answered with is known from then on
+    client.createEmployee("Grace", "Duplicate", "grace@example.com");
+    ASSERT_TRUE(completedSpy.wait(5000));
+    EXPECT_FALSE(completedSpy.at(1).at(0).toBool());
+    EXPECT_EQ(mutationCount(server), 1);
+    EXPECT_EQ(client.avoidedRoundTrips(), 1);
+}
+
+TEST(ApiClientTest, AcceptsInactiveManager) {
+    FakeApiServer server(directoryApi());
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    QSignalSpy employeesSpy(&client, &ApiClient::employeesReceived);
+    QSignalSpy completedSpy(&client, &ApiClient::operationCompleted);
+
+    // The active-only list does not show emp-2, which proves nothing
+    client.getEmployees(false);
+    ASSERT_TRUE(employeesSpy.wait(5000));
+    client.updateEmployee("emp-1", QJsonObject{{"manager_id", "emp-2"}});
+    ASSERT_TRUE(completedSpy.wait(5000));
+    EXPECT_TRUE(completedSpy.at(0).at(0).toBool());
+
+    client.getEmployees(true);
+    ASSERT_TRUE(employeesSpy.wait(5000));
+    client.updateEmployee("emp-1", QJsonObject{{"manager_id", "emp-2"}});
+    ASSERT_TRUE(completedSpy.wait(5000));
+    EXPECT_TRUE(completedSpy.at(1).at(0).toBool());
+
+    EXPECT_EQ(mutationCount(server), 2);
+    EXPECT_EQ(client.avoidedRoundTrips(), 0);
+}
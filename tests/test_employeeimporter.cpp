@@ -0,0 +1,161 @@
+#include "api/employeeimporter.h"
+#include "fakeapiserver.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace {
+
+// Serves one department, one grade and one existing employee, and stores every POSTed
+// employee under a generated id
+FakeApiServer::Handler importApi() {
+    return [](const FakeRequest& request) {
+        FakeResponse response;
+        if (request.method == "GET") {
+            QJsonArray items;
+            if (request.path.contains("departments"))
+                items.append(QJsonObject{{"id", "dept-1"}, {"name", "Engineering"}});
+            else if (request.path.contains("salary-grades"))
+                items.append(QJsonObject{{"id", "grade-1"}, {"code", "E1"}, {"base_salary", 1}});
+            else
+                items.append(QJsonObject{{"id", "emp-0"},
+                                         {"first_name", "Ada"},
+                                         {"last_name", "Lovelace"},
+                                         {"email", "ada@example.com"}});
+            response.body = QJsonDocument(items).toJson();
+            return response;
+        }
+        QJsonObject entity = QJsonDocument::fromJson(request.body).object();
+        entity["id"] = "emp-" + entity["email"].toString();
+        response.status = 201;
+        response.body = QJsonDocument(entity).toJson();
+        return response;
+    };
+}
+
+QString writeFile(const QTemporaryDir& dir, const QString& name, const QByteArray& content) {
+    QString path = dir.filePath(name);
+    QFile file(path);
+    file.open(QIODevice::WriteOnly);
+    file.write(content);
+    return path;
+}
+
+QList<QJsonObject> postedBodies(const FakeApiServer& server) {
+    QList<QJsonObject> bodies;
+    for (const FakeRequest& request : server.requests()) {
+        if (request.method == "POST")
+            bodies.append(QJsonDocument::fromJson(request.body).object());
+    }
+    return bodies;
+}
+
+} // namespace
+
+TEST(EmployeeImporterTest, ImportsCsvAndReportsRowFailures) {
+    FakeApiServer server(importApi());
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    EmployeeImporter importer(&client);
+    QSignalSpy finishedSpy(&importer, &EmployeeImporter::finished);
+
+    QTemporaryDir dir;
+    QString path = writeFile(dir, "staff.csv",
+                             "first_name,last_name,email,department,salary_grade,hire_date\n"
+                             "Grace,Hopper,grace@example.com,engineering,E1,2020-01-15\n"
+                             "Alan,Turing,not-an-email,Engineering,E1,\n"
+                             "Linus,Torvalds,linus@example.com,Kernel,E1,\n"
+                             "Ada,Lovelace,ADA@example.com,,,\n"
+                             "Edsger,\"Dijkstra, W.\",edsger@example.com,,,\n");
+    ASSERT_TRUE(importer.start(path));
+    ASSERT_TRUE(finishedSpy.wait(5000));
+
+    EXPECT_EQ(importer.summary().imported, 2);
+    EXPECT_EQ(importer.summary().failed, 3);
+    ASSERT_EQ(importer.errors().size(), 3);
+    QList<int> failedRows;
+    for (const EmployeeImporter::RowError& error : importer.errors())
+        failedRows.append(error.row);
+    std::sort(failedRows.begin(), failedRows.end());
+    EXPECT_EQ(failedRows, QList<int>({2, 3, 4}));
+
+    // Codes are resolved to ids locally, and only valid rows reach the server
+    QList<QJsonObject> posted = postedBodies(server);
+    ASSERT_EQ(posted.size(), 2);
+    for (const QJsonObject& body : posted) {
+        if (body["email"].toString() == "grace@example.com") {
+            EXPECT_EQ(body["department_id"].toString(), "dept-1");
+            EXPECT_EQ(body["salary_grade_id"].toString(), "grade-1");
+        } else {
+            EXPECT_EQ(body["last_name"].toString(), "Dijkstra, W.");
+        }
+    }
+
+    // Kept so the failed rows can be fixed and resumed
+    EXPECT_TRUE(QFile::exists(EmployeeImporter::journalPathFor(path)));
+}
+
+TEST(EmployeeImporterTest, ResumeSkipsRowsAlreadyImported) {
+    FakeApiServer server(importApi());
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    EmployeeImporter importer(&client);
+    QSignalSpy finishedSpy(&importer, &EmployeeImporter::finished);
+
+    QTemporaryDir dir;
+    QJsonArray rows;
+    rows.append(QJsonObject{{"first_name", "Ada"},
+                            {"last_name", "Lovelace"},
+                            {"email", "ada@example.com"}});
+    rows.append(QJsonObject{{"first_name", "Grace"},
+                            {"last_name", "Hopper"},
+                            {"email", "grace@example.com"}});
+    rows.append(QJsonObject{{"first_name", "Alan"},
+                            {"last_name", "Turing"},
+                            {"email", "alan@example.com"},
+                            {"active", false}});
+    QString path = writeFile(dir, "staff.json", QJsonDocument(rows).toJson());
+    // The interrupted run journaled row 2; row 1 was sent but its reply never journaled
+    writeFile(dir, "staff.json.import-journal", "2\n");
+
+    EmployeeImporter::Options options;
+    options.window = 1;
+    options.resume = true;
+    ASSERT_TRUE(importer.start(path, options));
+    ASSERT_TRUE(finishedSpy.wait(5000));
+
+    EXPECT_EQ(importer.summary().imported, 1);
+    EXPECT_EQ(importer.summary().skipped, 2);
+    EXPECT_EQ(importer.summary().failed, 0);
+    QList<QJsonObject> posted = postedBodies(server);
+    ASSERT_EQ(posted.size(), 1);
+    EXPECT_EQ(posted.first()["email"].toString(), "alan@example.com");
+    EXPECT_FALSE(posted.first()["active"].toBool());
+    EXPECT_FALSE(QFile::exists(EmployeeImporter::journalPathFor(path)));
+}
+
+TEST(EmployeeImporterTest, StopsOnTruncatedJson) {
+    FakeApiServer server(importApi());
+    ApiClient client;
+    client.setApiUrl(server.apiUrl());
+    EmployeeImporter importer(&client);
+    QSignalSpy failedSpy(&importer, &EmployeeImporter::failed);
+
+    QTemporaryDir dir;
+    QString path = writeFile(dir, "staff.json",
+                             "[{\"first_name\": \"Grace\", \"last_name\": \"Hopper\", "
+                             "\"email\": \"grace@example.com\"}, {\"first_name\": ");
+    ASSERT_TRUE(importer.start(path));
+    ASSERT_TRUE(failedSpy.wait(5000));
+
+    // The complete row before the damage still went through
+    EXPECT_EQ(importer.summary().imported, 1);
+    EXPECT_FALSE(importer.isRunning());
+}
@@ -0,0 +1,64 @@
+#include "api/jsonarrayreader.h"
+
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// Feeds `payload` in chunks of `chunkSize` bytes and collects the "id" of every element
+QStringList readIds(const QByteArray& payload, int chunkSize, JsonArrayReader& reader) {
+    QStringList ids;
+    QJsonObject element;
+    for (int pos = 0; pos < payload.size(); pos += chunkSize) {
+        reader.addData(payload.mid(pos, chunkSize));
+        while (reader.readNext(element))
+            ids.append(element["id"].toString());
+    }
+    return ids;
+}
+
+} // namespace
+
+// ============================================================================
+// Streaming Array Reader Tests
+// ============================================================================
+
+TEST(JsonArrayReaderTest, ReadsElementsAcrossChunkBoundaries) {
+    QByteArray payload = R"( [ {"id": "emp-1", "first_name": "Jo}]n", "tags": ["a", {"b": 1}]},
+                               {"id": "emp-2", "last_name": "Quote \" [Doe"} ] )";
+
+    for (int chunkSize : {1, 2, 7, 64, 4096}) {
+        JsonArrayReader reader;
+        QStringList ids = readIds(payload, chunkSize, reader);
+
+        EXPECT_EQ(ids, QStringList({"emp-1", "emp-2"})) << "chunk size " << chunkSize;
+        EXPECT_TRUE(reader.atEnd());
+        EXPECT_FALSE(reader.hasError());
+    }
+}
+
+TEST(JsonArrayReaderTest, ReportsTruncatedPayloadAsIncomplete) {
+    JsonArrayReader reader;
+    QStringList ids = readIds(R"([{"id": "emp-1"}, {"id": "em)", 4, reader);
+
+    EXPECT_EQ(ids, QStringList({"emp-1"}));
+    EXPECT_FALSE(reader.atEnd());
+    EXPECT_FALSE(reader.hasError());
+}
+
+TEST(JsonArrayReaderTest, RejectsNonArrayPayload) {
+    JsonArrayReader reader;
+    QStringList ids = readIds(R"({"error": "not found"})", 8, reader);
+
+    EXPECT_TRUE(ids.isEmpty());
+    EXPECT_TRUE(reader.hasError());
+}
+
+TEST(JsonArrayReaderTest, ReadsEmptyArray) {
+    JsonArrayReader reader;
+    QStringList ids = readIds("[]", 1, reader);
+
+    EXPECT_TRUE(ids.isEmpty());
+    EXPECT_TRUE(reader.atEnd());
+}
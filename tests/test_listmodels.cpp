@@ -0,0 +1,736 @@
+#include "models/departmentfiltermodel.h"
+#include "models/departmentlistmodel.h"
+#include "models/employeecompletionmodel.h"
+#include "models/employeefiltermodel.h"
+#include "models/employeelistmodel.h"
+#include "models/payrollmodel.h"
+#include "models/salarygradelistmodel.h"
+#include "models/salarystatisticsmodel.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace {
+
+Employee makeEmployee(const QString& id, const QString& first, const QString& last,
+                      const QString& deptId = QString()) {
+    Employee emp;
+    emp.id = id;
+    emp.firstName = first;
+    emp.lastName = last;
+    emp.email = first.toLower() + "@example.com";
+    emp.role = "Employee";
+    emp.departmentId = deptId;
+    return emp;
+}
+
+Department makeDepartment(const QString& id, const QString& name,
+                          const QString& headId = QString()) {
+    return Department(id, name, headId);
+}
+
+// Matching runs on the thread pool; waits until the filter has caught up
+bool waitForFilter(AsyncFilterModel& filter) {
+    return QTest::qWaitFor([&filter]() { return !filter.isBusy(); });
+}
+
+void search(AsyncFilterModel& filter, const QString& text) {
+    filter.setFilterText(text);
+    EXPECT_TRUE(waitForFilter(filter));
+}
+
+} // namespace
+
+// ============================================================================
+// List Model Tests
+// ============================================================================
+
+TEST(EmployeeListModelTest, ExposesRolesByName) {
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe", "dept-1")});
+
+    QHash<int, QByteArray> roles = model.roleNames();
+    EXPECT_EQ(roles.value(EmployeeListModel::FirstNameRole), "firstName");
+    EXPECT_EQ(roles.value(EmployeeListModel::DepartmentIdRole), "departmentId");
+
+    QModelIndex index = model.index(0);
+    EXPECT_EQ(model.data(index, EmployeeListModel::IdRole).toString(), "emp-1");
+    EXPECT_EQ(model.data(index, EmployeeListModel::FullNameRole).toString(), "John Doe");
+    EXPECT_EQ(model.data(index, EmployeeListModel::DepartmentIdRole).toString(), "dept-1");
+    EXPECT_FALSE(model.data(model.index(1), EmployeeListModel::IdRole).isValid());
+}
+
+TEST(EmployeeListModelTest, LooksUpRowsById) {
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe"), makeEmployee("emp-2", "Jane", "Roe")});
+
+    EXPECT_EQ(model.count(), 2);
+    EXPECT_EQ(model.indexOfId("emp-2"), 1);
+    EXPECT_EQ(model.indexOfId("missing"), -1);
+    EXPECT_EQ(model.fullNameOf("emp-1"), "John Doe");
+    EXPECT_TRUE(model.fullNameOf("missing").isEmpty());
+}
+
+TEST(EmployeeListModelTest, CountChangesWithItems) {
+    EmployeeListModel model;
+    QSignalSpy countSpy(&model, &EmployeeListModel::countChanged);
+
+    model.setItems({makeEmployee("emp-1", "John", "Doe")});
+
+    EXPECT_GE(countSpy.count(), 1);
+    EXPECT_EQ(model.count(), 1);
+}
+
+TEST(EmployeeListModelTest, RefreshUpdatesChangedRowInPlace) {
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe"), makeEmployee("emp-2", "Jane", "Roe")});
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+
+    model.setItems({makeEmployee("emp-1", "John", "Doe"), makeEmployee("emp-2", "Jane", "Smith")});
+
+    EXPECT_EQ(resetSpy.count(), 0);
+    ASSERT_EQ(changedSpy.count(), 1);
+    EXPECT_EQ(changedSpy.at(0).at(0).value<QModelIndex>().row(), 1);
+    EXPECT_EQ(model.fullNameOf("emp-2"), "Jane Smith");
+}
+
+TEST(EmployeeListModelTest, RefreshInsertsAndRemovesByKey) {
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe"), makeEmployee("emp-2", "Jane", "Roe")});
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removedSpy(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+
+    model.setItems(
+        {makeEmployee("emp-2", "Jane", "Roe"), makeEmployee("emp-3", "Max", "Mustermann")});
+
+    EXPECT_EQ(resetSpy.count(), 0);
+    EXPECT_EQ(removedSpy.count(), 1);
+    EXPECT_EQ(insertedSpy.count(), 1);
+    EXPECT_EQ(changedSpy.count(), 0);
+    EXPECT_EQ(model.indexOfId("emp-1"), -1);
+    EXPECT_EQ(model.indexOfId("emp-2"), 0);
+    EXPECT_EQ(model.indexOfId("emp-3"), 1);
+}
+
+TEST(EmployeeListModelTest, RefreshAppliesLargeReorder) {
+    QList<Employee> employees;
+    for (int i = 0; i < 40; ++i)
+        employees.append(makeEmployee(QString("emp-%1").arg(i), "First", "Last"));
+    EmployeeListModel model;
+    model.setItems(employees);
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+
+    // Reversed, with every third row dropped and a new one in the middle
+    QList<Employee> reordered;
+    for (int i = 39; i >= 0; --i) {
+        if (i % 3 != 0)
+            reordered.append(employees.at(i));
+        if (i == 20)
+            reordered.append(makeEmployee("emp-new", "New", "Hire"));
+    }
+    model.setItems(reordered);
+
+    EXPECT_EQ(resetSpy.count(), 0);
+    ASSERT_EQ(model.count(), reordered.size());
+    for (int row = 0; row < reordered.size(); ++row) {
+        EXPECT_EQ(model.items().at(row).id, reordered.at(row).id);
+        EXPECT_EQ(model.indexOfId(reordered.at(row).id), row);
+    }
+}
+
+TEST(EmployeeListModelTest, UpsertPatchesOrAppendsById) {
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe"), makeEmployee("emp-2", "Jane", "Roe")});
+    QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+
+    model.upsert(makeEmployee("emp-1", "John", "Smith"));
+    model.upsert(makeEmployee("emp-3", "Max", "Mustermann"));
+    model.upsert(makeEmployee("emp-3", "Max", "Mustermann"));
+
+    EXPECT_EQ(changedSpy.count(), 1);
+    EXPECT_EQ(insertedSpy.count(), 1);
+    EXPECT_EQ(model.count(), 3);
+    EXPECT_EQ(model.fullNameOf("emp-1"), "John Smith");
+    EXPECT_EQ(model.indexOfId("emp-3"), 2);
+}
+
+TEST(EmployeeListModelTest, RemoveIdKeepsIndexConsistent) {
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe"), makeEmployee("emp-2", "Jane", "Roe"),
+                    makeEmployee("emp-3", "Max", "Mustermann")});
+
+    EXPECT_TRUE(model.removeId("emp-1"));
+    EXPECT_FALSE(model.removeId("emp-1"));
+
+    EXPECT_EQ(model.count(), 2);
+    EXPECT_EQ(model.indexOfId("emp-2"), 0);
+    EXPECT_EQ(model.indexOfId("emp-3"), 1);
+}
+
+TEST(DepartmentListModelTest, RefreshMovesReorderedRow) {
+    DepartmentListModel model;
+    model.setItems({makeDepartment("dept-1", "Engineering"), makeDepartment("dept-2", "Finance"),
+                    makeDepartment("dept-3", "Sales")});
+    QSignalSpy movedSpy(&model, &QAbstractItemModel::rowsMoved);
+    QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removedSpy(&model, &QAbstractItemModel::rowsRemoved);
+
+    // Renamed so it sorts last
+    model.setItems({makeDepartment("dept-2", "Finance"), makeDepartment("dept-3", "Sales"),
+                    makeDepartment("dept-1", "Technology")});
+
+    EXPECT_EQ(movedSpy.count(), 1);
+    EXPECT_EQ(insertedSpy.count(), 0);
+    EXPECT_EQ(removedSpy.count(), 0);
+    EXPECT_EQ(model.indexOfId("dept-1"), 2);
+    EXPECT_EQ(model.indexOfId("dept-2"), 0);
+    EXPECT_EQ(model.nameOf("dept-1"), "Technology");
+}
+
+TEST(EmployeeListModelTest, KeepsEmailAndManagerIndicesCurrent) {
+    Employee report = makeEmployee("emp-2", "Jane", "Roe");
+    report.managerId = "emp-1";
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe"), report});
+
+    EXPECT_EQ(model.idOfEmail(" JANE@example.com"), "emp-2");
+    EXPECT_EQ(model.reportIdsOf("emp-1"), QStringList({"emp-2"}));
+
+    report.email = "jane.roe@example.com";
+    report.managerId.clear();
+    model.upsert(report);
+    model.removeId("emp-1");
+
+    EXPECT_TRUE(model.idOfEmail("jane@example.com").isEmpty());
+    EXPECT_EQ(model.idOfEmail("jane.roe@example.com"), "emp-2");
+    EXPECT_TRUE(model.idOfEmail("john@example.com").isEmpty());
+    EXPECT_TRUE(model.reportIdsOf("emp-1").isEmpty());
+}
+
+TEST(EmployeeListModelTest, KeepsColumnsInStepWithRows) {
+    Employee first = makeEmployee("emp-1", "John", "Doe", "dept-1");
+    first.salaryGradeId = "grade-1";
+    first.hireDate = QDateTime(QDate(2020, 1, 15), QTime(0, 0), Qt::UTC);
+    Employee second = makeEmployee("emp-2", "Jane", "Roe", "dept-2");
+    second.salaryGradeId = "grade-2";
+    second.active = false;
+    Employee third = makeEmployee("emp-3", "Max", "Poe", "dept-1");
+    third.salaryGradeId = "grade-2";
+    EmployeeListModel model;
+    model.setItems({first, second, third});
+
+    const EmployeeColumns& columns = model.columns();
+    ASSERT_EQ(columns.size(), 3);
+    qint32 dept1 = columns.departmentIndexOf("dept-1");
+    qint32 dept2 = columns.departmentIndexOf("dept-2");
+    EXPECT_EQ(columns.countByDepartment().at(dept1), 2);
+    EXPECT_EQ(columns.countByDepartment(true).at(dept2), 0);
+    EXPECT_EQ(columns.countByGrade().at(columns.gradeIndexOf("grade-2")), 2);
+
+    QList<double> salaryByGrade(columns.gradeIds().size());
+    salaryByGrade[columns.gradeIndexOf("grade-1")] = 1000;
+    salaryByGrade[columns.gradeIndexOf("grade-2")] = 500;
+    EXPECT_EQ(columns.sumByDepartment(salaryByGrade).at(dept1), 1500);
+    qint64 hired = first.hireDate.toMSecsSinceEpoch();
+    EXPECT_EQ(columns.countHiredBetween(hired, hired + 1), 1);
+
+    // Edits move employees between buckets, removals drop them
+    third.departmentId = "dept-2";
+    model.upsert(third);
+    model.removeId("emp-1");
+    EXPECT_EQ(columns.size(), 2);
+    EXPECT_FALSE(columns.contains("emp-1"));
+    EXPECT_EQ(columns.countByDepartment().at(dept1), 0);
+    EXPECT_EQ(columns.countByDepartment().at(dept2), 2);
+    EXPECT_EQ(columns.sumByDepartment(salaryByGrade).at(dept2), 1000);
+    EXPECT_EQ(columns.countHiredBetween(hired, hired + 1), 0);
+}
+
+TEST(EmployeeListModelTest, AnswersReportingChainQueries) {
+    // ceo <- vp <- lead <- dev, and ceo <- cfo; the dev arrives before their manager
+    auto reportingTo = [](const QString& id, const QString& managerId) {
+        Employee employee = makeEmployee(id, "First" + id, "Last" + id);
+        employee.managerId = managerId;
+        return employee;
+    };
+    EmployeeListModel model;
+    model.setItems({reportingTo("dev", "lead"), reportingTo("ceo", QString()),
+                    reportingTo("vp", "ceo"), reportingTo("cfo", "ceo")});
+    model.upsert(reportingTo("lead", "vp"));
+
+    QStringList underCeo = model.allReportIdsOf("ceo");
+    std::sort(underCeo.begin(), underCeo.end());
+    EXPECT_EQ(underCeo, QStringList({"cfo", "dev", "lead", "vp"}));
+    EXPECT_EQ(model.chainOfCommandOf("dev"), QStringList({"lead", "vp", "ceo"}));
+    EXPECT_TRUE(model.hierarchy().isAbove("vp", "dev"));
+    EXPECT_FALSE(model.hierarchy().isAbove("cfo", "dev"));
+    EXPECT_EQ(model.hierarchy().spanOfControl("ceo"), 2);
+    EXPECT_EQ(model.hierarchy().reportCountUnder("vp"), 2);
+
+    EXPECT_TRUE(model.wouldCreateCycle("vp", "dev"));
+    EXPECT_TRUE(model.wouldCreateCycle("vp", "vp"));
+    EXPECT_FALSE(model.wouldCreateCycle("dev", "cfo"));
+    EXPECT_FALSE(model.wouldCreateCycle("dev", QString()));
+
+    // Moving the lead carries their report along
+    model.upsert(reportingTo("lead", "cfo"));
+    EXPECT_EQ(model.allReportIdsOf("vp"), QStringList());
+    EXPECT_EQ(model.chainOfCommandOf("dev"), QStringList({"lead", "cfo", "ceo"}));
+    EXPECT_TRUE(model.wouldCreateCycle("cfo", "dev"));
+    EXPECT_FALSE(model.wouldCreateCycle("vp", "dev"));
+
+    // The chain stops at a manager who is gone; the report comes back with them
+    model.removeId("cfo");
+    EXPECT_EQ(model.chainOfCommandOf("dev"), QStringList({"lead"}));
+    EXPECT_EQ(model.reportIdsOf("cfo"), QStringList({"lead"}));
+    model.upsert(reportingTo("cfo", "ceo"));
+    EXPECT_EQ(model.chainOfCommandOf("dev"), QStringList({"lead", "cfo", "ceo"}));
+}
+
+TEST(EmployeeListModelTest, ResolvesDepartmentNameForMembersOnly) {
+    DepartmentListModel departments;
+    departments.setItems(
+        {makeDepartment("dept-1", "Engineering"), makeDepartment("dept-2", "Finance")});
+    EmployeeListModel model;
+    model.setItems({makeEmployee("emp-1", "John", "Doe", "dept-1"),
+                    makeEmployee("emp-2", "Jane", "Roe", "dept-2")});
+    model.setDepartmentModel(&departments);
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+
+    departments.upsert(makeDepartment("dept-2", "Accounting"));
+
+    ASSERT_EQ(changedSpy.count(), 1);
+    EXPECT_EQ(changedSpy.at(0).at(0).value<QModelIndex>().row(), 1);
+    EXPECT_EQ(changedSpy.at(0).at(2).value<QList<int>>(),
+              QList<int>({EmployeeListModel::DepartmentNameRole}));
+    EXPECT_EQ(model.data(model.index(1), EmployeeListModel::DepartmentNameRole).toString(),
+              "Accounting");
+    EXPECT_EQ(model.memberIdsOf("dept-1"), QStringList({"emp-1"}));
+}
+
+TEST(DepartmentListModelTest, ResolvesHeadName) {
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "John", "Doe")});
+    DepartmentListModel model;
+    model.setItems({makeDepartment("dept-1", "Engineering", "emp-1")});
+    model.setEmployeeModel(&employees);
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+
+    employees.upsert(makeEmployee("emp-1", "John", "Smith"));
+
+    EXPECT_EQ(changedSpy.count(), 1);
+    EXPECT_EQ(model.data(model.index(0), DepartmentListModel::HeadNameRole).toString(),
+              "John Smith");
+    EXPECT_EQ(model.idsHeadedBy("emp-1"), QStringList({"dept-1"}));
+}
+
+TEST(DepartmentListModelTest, HeadInOwnDepartmentDoesNotBounce) {
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "John", "Doe", "dept-1")});
+    DepartmentListModel departments;
+    departments.setItems({makeDepartment("dept-1", "Engineering", "emp-1")});
+    employees.setDepartmentModel(&departments);
+    departments.setEmployeeModel(&employees);
+    QSignalSpy employeeSpy(&employees, &QAbstractItemModel::dataChanged);
+    QSignalSpy departmentSpy(&departments, &QAbstractItemModel::dataChanged);
+
+    employees.upsert(makeEmployee("emp-1", "John", "Smith", "dept-1"));
+    EXPECT_EQ(employeeSpy.count(), 1);
+    EXPECT_EQ(departmentSpy.count(), 1);
+
+    departments.upsert(makeDepartment("dept-1", "Research", "emp-1"));
+    EXPECT_EQ(employeeSpy.count(), 2);
+    EXPECT_EQ(departmentSpy.count(), 2);
+    EXPECT_EQ(employees.data(employees.index(0), EmployeeListModel::DepartmentNameRole).toString(),
+              "Research");
+
+    // Only the departments the employee heads are told about arrivals and departures
+    employees.upsert(makeEmployee("emp-2", "Jane", "Roe", "dept-1"));
+    EXPECT_EQ(departmentSpy.count(), 2);
+    employees.removeId("emp-1");
+    ASSERT_EQ(departmentSpy.count(), 3);
+    EXPECT_EQ(departmentSpy.at(2).at(2).value<QList<int>>(),
+              QList<int>({DepartmentListModel::HeadNameRole}));
+    EXPECT_TRUE(departments.data(departments.index(0), DepartmentListModel::HeadNameRole)
+                    .toString()
+                    .isEmpty());
+}
+
+TEST(SalaryGradeListModelTest, FormatsLabel) {
+    SalaryGrade grade;
+    grade.id = "grade-1";
+    grade.code = "E3";
+    grade.baseSalary = 65000.4;
+
+    SalaryGradeListModel model;
+    model.setItems({grade});
+
+    EXPECT_EQ(model.labelOf("grade-1"), "E3 - $65000");
+    EXPECT_EQ(model.codeOf("grade-1"), "E3");
+    EXPECT_EQ(model.data(model.index(0), SalaryGradeListModel::BaseSalaryRole).toDouble(),
+              65000.4);
+}
+
+// ============================================================================
+// Filter Model Tests
+// ============================================================================
+
+TEST(EmployeeFilterModelTest, MatchesNameEmailAndDepartment) {
+    DepartmentListModel departments;
+    departments.setItems({makeDepartment("dept-1", "Engineering")});
+
+    EmployeeListModel employees;
+    employees.setDepartmentModel(&departments);
+    employees.setItems({makeEmployee("emp-1", "John", "Doe", "dept-1"),
+                        makeEmployee("emp-2", "Jane", "Roe")});
+
+    EmployeeFilterModel filter;
+    filter.setSourceModel(&employees);
+    EXPECT_EQ(filter.count(), 2);
+
+    search(filter, "roe");
+    ASSERT_EQ(filter.count(), 1);
+    EXPECT_EQ(filter.data(filter.index(0, 0), EmployeeListModel::IdRole).toString(), "emp-2");
+
+    search(filter, "engineer");
+    ASSERT_EQ(filter.count(), 1);
+    EXPECT_EQ(filter.data(filter.index(0, 0), EmployeeListModel::IdRole).toString(), "emp-1");
+
+    search(filter, "jane@");
+    EXPECT_EQ(filter.count(), 1);
+
+    search(filter, "   ");
+    EXPECT_EQ(filter.count(), 2);
+}
+
+TEST(EmployeeFilterModelTest, ReevaluatesWhenDepartmentsChange) {
+    DepartmentListModel departments;
+    EmployeeListModel employees;
+    employees.setDepartmentModel(&departments);
+    employees.setItems({makeEmployee("emp-1", "John", "Doe", "dept-1")});
+
+    EmployeeFilterModel filter;
+    filter.setSourceModel(&employees);
+    search(filter, "sales");
+    EXPECT_EQ(filter.count(), 0);
+
+    departments.setItems({makeDepartment("dept-1", "Sales")});
+    ASSERT_TRUE(waitForFilter(filter));
+    EXPECT_EQ(filter.count(), 1);
+
+    departments.upsert(makeDepartment("dept-1", "Marketing"));
+    ASSERT_TRUE(waitForFilter(filter));
+    EXPECT_EQ(filter.count(), 0);
+}
+
+TEST(EmployeeFilterModelTest, OrdersByMatchQuality) {
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "Anna", "Johnson"),
+                        makeEmployee("emp-2", "Mark", "Stone"),
+                        makeEmployee("emp-3", "John", "Doe")});
+
+    EmployeeFilterModel filter;
+    filter.setSourceModel(&employees);
+    search(filter, "john");
+    ASSERT_EQ(filter.count(), 2);
+    // Name prefix before a match later in the name
+    EXPECT_EQ(filter.data(filter.index(0, 0), EmployeeListModel::IdRole).toString(), "emp-3");
+    EXPECT_EQ(filter.data(filter.index(1, 0), EmployeeListModel::IdRole).toString(), "emp-1");
+
+    // Edits to the source are picked up while the query stays the same
+    employees.upsert(makeEmployee("emp-2", "Johnny", "Stone"));
+    ASSERT_TRUE(waitForFilter(filter));
+    EXPECT_EQ(filter.count(), 3);
+
+    search(filter, "");
+    ASSERT_EQ(filter.count(), 3);
+    EXPECT_EQ(filter.data(filter.index(0, 0), EmployeeListModel::IdRole).toString(), "emp-1");
+}
+
+TEST(EmployeeFilterModelTest, DebouncesAndNarrowsIncrementally) {
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "John", "Doe"), makeEmployee("emp-2", "Jane", "Roe"),
+                        makeEmployee("emp-3", "Joan", "Smith")});
+
+    EmployeeFilterModel filter;
+    filter.setSourceModel(&employees);
+
+    // Rows stay as they are until the latest query has been matched
+    filter.setFilterText("j");
+    filter.setFilterText("jo");
+    EXPECT_TRUE(filter.isBusy());
+    EXPECT_EQ(filter.count(), 3);
+    ASSERT_TRUE(waitForFilter(filter));
+    EXPECT_EQ(filter.count(), 2);
+
+    QSignalSpy resetSpy(&filter, &QAbstractItemModel::modelReset);
+    QSignalSpy layoutSpy(&filter, &QAbstractItemModel::layoutChanged);
+    QSignalSpy removedSpy(&filter, &QAbstractItemModel::rowsRemoved);
+    search(filter, "joh");
+    ASSERT_EQ(filter.count(), 1);
+    EXPECT_EQ(filter.data(filter.index(0, 0), EmployeeListModel::IdRole).toString(), "emp-1");
+    EXPECT_EQ(removedSpy.count(), 1);
+    EXPECT_EQ(layoutSpy.count(), 0);
+    EXPECT_EQ(resetSpy.count(), 0);
+}
+
+TEST(EmployeeFilterModelTest, RescansAfterSourceChanges) {
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "John", "Doe")});
+
+    EmployeeFilterModel filter;
+    filter.setSourceModel(&employees);
+    search(filter, "jo");
+    EXPECT_EQ(filter.count(), 1);
+
+    // Not among the earlier matches, so narrowing them would miss it
+    employees.upsert(makeEmployee("emp-2", "Jody", "Fox"));
+    search(filter, "jod");
+    ASSERT_EQ(filter.count(), 1);
+    EXPECT_EQ(filter.data(filter.index(0, 0), EmployeeListModel::IdRole).toString(), "emp-2");
+}
+
+TEST(EmployeeCompletionModelTest, ListsBestMatchesWithinLimit) {
+    Employee manager = makeEmployee("emp-3", "Johanna", "Berg", "dept-2");
+    manager.role = "manager";
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "Anna", "Johnson", "dept-1"),
+                        makeEmployee("emp-2", "John", "Doe", "dept-1"), manager});
+
+    EmployeeCompletionModel completions;
+    completions.setEmployeeModel(&employees);
+    completions.setLimit(2);
+    completions.setQuery("joh");
+    ASSERT_EQ(completions.count(), 2);
+    EXPECT_TRUE(completions.isTruncated());
+    EXPECT_EQ(completions.items().at(0).id, "emp-3");
+    EXPECT_EQ(completions.items().at(1).id, "emp-2");
+
+    completions.setDepartmentFilter("dept-1");
+    ASSERT_EQ(completions.count(), 2);
+    EXPECT_FALSE(completions.isTruncated());
+    EXPECT_EQ(completions.items().at(0).id, "emp-2");
+    EXPECT_EQ(completions.items().at(1).id, "emp-1");
+
+    completions.setDepartmentFilter(QString());
+    completions.setRoleFilter("manager");
+    ASSERT_EQ(completions.count(), 1);
+    EXPECT_EQ(completions.items().at(0).fullName, "Johanna Berg");
+
+    completions.setActive(false);
+    EXPECT_EQ(completions.count(), 0);
+}
+
+TEST(EmployeeCompletionModelTest, FollowsSourceChangesWhileActive) {
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "John", "Doe")});
+
+    EmployeeCompletionModel completions;
+    completions.setEmployeeModel(&employees);
+    completions.setQuery("jo");
+    EXPECT_EQ(completions.count(), 1);
+
+    QSignalSpy countSpy(&completions, &EmployeeCompletionModel::countChanged);
+    employees.upsert(makeEmployee("emp-2", "Jody", "Fox"));
+    employees.upsert(makeEmployee("emp-3", "Joe", "Bloggs"));
+    ASSERT_TRUE(countSpy.wait());
+    EXPECT_EQ(completions.count(), 3);
+    EXPECT_EQ(countSpy.count(), 1);
+}
+
+TEST(DepartmentFilterModelTest, MatchesNameAndHead) {
+    EmployeeListModel employees;
+    employees.setItems({makeEmployee("emp-1", "John", "Doe")});
+
+    DepartmentListModel departments;
+    departments.setItems(
+        {makeDepartment("dept-1", "Engineering", "emp-1"), makeDepartment("dept-2", "Sales")});
+
+    DepartmentFilterModel filter;
+    filter.setSourceModel(&departments);
+    filter.setEmployeeModel(&employees);
+
+    search(filter, "sal");
+    ASSERT_EQ(filter.count(), 1);
+    EXPECT_EQ(filter.data(filter.index(0, 0), DepartmentListModel::IdRole).toString(), "dept-2");
+
+    search(filter, "john");
+    ASSERT_EQ(filter.count(), 1);
+    EXPECT_EQ(filter.data(filter.index(0, 0), DepartmentListModel::IdRole).toString(), "dept-1");
+}
+
+// ============================================================================
+// Payroll Model Tests
+// ============================================================================
+
+namespace {
+
+SalaryGrade makeGrade(const QString& id, const QString& code, double baseSalary) {
+    SalaryGrade grade;
+    grade.id = id;
+    grade.code = code;
+    grade.baseSalary = baseSalary;
+    return grade;
+}
+
+Employee makeGradedEmployee(const QString& id, const QString& deptId, const QString& gradeId,
+                            bool active = true) {
+    Employee emp = makeEmployee(id, "First" + id, "Last" + id, deptId);
+    emp.salaryGradeId = gradeId;
+    emp.active = active;
+    return emp;
+}
+
+template <typename Model>
+int rowOf(const Model& model, const QString& id) {
+    for (int row = 0; row < model.rowCount(); ++row) {
+        if (model.data(model.index(row), Model::IdRole).toString() == id)
+            return row;
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(PayrollModelTest, TotalsPerDepartmentAndGrade) {
+    SalaryGradeListModel grades;
+    grades.setItems({makeGrade("grade-1", "E1", 50000), makeGrade("grade-2", "E2", 80000)});
+    EmployeeListModel employees;
+    employees.setItems({makeGradedEmployee("emp-1", "dept-1", "grade-1"),
+                        makeGradedEmployee("emp-2", "dept-1", "grade-2"),
+                        makeGradedEmployee("emp-3", "dept-2", "grade-2"),
+                        makeGradedEmployee("emp-4", "dept-2", "grade-1", false)});
+    PayrollModel payroll;
+    payroll.setEmployeeModel(&employees);
+    payroll.setSalaryGradeModel(&grades);
+
+    ASSERT_EQ(payroll.count(), 2);
+    QModelIndex dept1 = payroll.index(rowOf(payroll, "dept-1"));
+    EXPECT_EQ(payroll.data(dept1, PayrollModel::HeadcountRole).toInt(), 2);
+    EXPECT_EQ(payroll.data(dept1, PayrollModel::TotalSalaryRole).toDouble(), 130000);
+    EXPECT_EQ(payroll.data(dept1, PayrollModel::MeanSalaryRole).toDouble(), 65000);
+    QModelIndex dept2 = payroll.index(rowOf(payroll, "dept-2"));
+    EXPECT_EQ(payroll.data(dept2, PayrollModel::HeadcountRole).toInt(), 1);
+    EXPECT_EQ(payroll.data(dept2, PayrollModel::TotalSalaryRole).toDouble(), 80000);
+
+    payroll.setGroupBy(PayrollModel::BySalaryGrade);
+    QModelIndex grade2 = payroll.index(rowOf(payroll, "grade-2"));
+    EXPECT_EQ(payroll.data(grade2, PayrollModel::NameRole).toString(), "E2");
+    EXPECT_EQ(payroll.data(grade2, PayrollModel::TotalSalaryRole).toDouble(), 160000);
+}
+
+TEST(PayrollModelTest, FollowsGradeAndEmployeeChanges) {
+    SalaryGradeListModel grades;
+    grades.setItems({makeGrade("grade-1", "E1", 50000), makeGrade("grade-2", "E2", 80000)});
+    EmployeeListModel employees;
+    employees.setItems({makeGradedEmployee("emp-1", "dept-1", "grade-1"),
+                        makeGradedEmployee("emp-2", "dept-2", "grade-2")});
+    PayrollModel payroll;
+    payroll.setEmployeeModel(&employees);
+    payroll.setSalaryGradeModel(&grades);
+    QSignalSpy changedSpy(&payroll, &QAbstractItemModel::dataChanged);
+
+    // Only the department using the grade is touched
+    grades.upsert(makeGrade("grade-1", "E1", 55000));
+    ASSERT_TRUE(changedSpy.wait());
+    ASSERT_EQ(changedSpy.count(), 1);
+    EXPECT_EQ(changedSpy.at(0).at(0).value<QModelIndex>().row(), rowOf(payroll, "dept-1"));
+    EXPECT_EQ(payroll.engine().departmentTotals("dept-1").totalSalary, 55000);
+    EXPECT_EQ(payroll.engine().gradeTotals("grade-1").totalSalary, 55000);
+
+    // Moving the last member out drops the department's row, a new one gets a row
+    QSignalSpy countSpy(&payroll, &PayrollModel::countChanged);
+    employees.upsert(makeGradedEmployee("emp-1", "dept-3", "grade-2"));
+    ASSERT_TRUE(countSpy.wait());
+    EXPECT_EQ(rowOf(payroll, "dept-1"), -1);
+    ASSERT_GE(rowOf(payroll, "dept-3"), 0);
+    EXPECT_EQ(payroll.engine().departmentTotals("dept-3").totalSalary, 80000);
+    EXPECT_EQ(payroll.engine().gradeTotals("grade-2").headcount, 2);
+
+    // Employees of a deleted grade stay counted, without salary
+    grades.removeId("grade-2");
+    EXPECT_EQ(payroll.engine().departmentTotals("dept-2").headcount, 1);
+    EXPECT_EQ(payroll.engine().departmentTotals("dept-2").totalSalary, 0);
+}
+
+TEST(SalaryStatisticsModelTest, DistributionPerDepartmentAndGrade) {
+    SalaryGradeListModel grades;
+    grades.setItems({makeGrade("grade-1", "E1", 40000), makeGrade("grade-2", "E2", 60000),
+                     makeGrade("grade-3", "E3", 100000)});
+    EmployeeListModel employees;
+    employees.setItems({makeGradedEmployee("emp-1", "dept-1", "grade-1"),
+                        makeGradedEmployee("emp-2", "dept-1", "grade-2"),
+                        makeGradedEmployee("emp-3", "dept-1", "grade-3"),
+                        makeGradedEmployee("emp-4", "dept-2", "grade-3"),
+                        makeGradedEmployee("emp-5", "dept-2", "grade-1", false),
+                        makeGradedEmployee("emp-6", "dept-2", "unknown-grade")});
+    SalaryStatisticsModel statistics;
+    statistics.setEmployeeModel(&employees);
+    statistics.setSalaryGradeModel(&grades);
+    statistics.recompute();
+
+    // Inactive employees and unknown grades are left out
+    const SalaryDistribution& organization = statistics.organizationDistribution();
+    EXPECT_EQ(organization.count, 4);
+    EXPECT_DOUBLE_EQ(organization.mean, 75000);
+    EXPECT_DOUBLE_EQ(organization.min, 40000);
+    EXPECT_DOUBLE_EQ(organization.p50, 80000);
+    EXPECT_EQ(statistics.organization().value("count").toInt(), 4);
+
+    ASSERT_EQ(statistics.rowCount(), 2);
+    QModelIndex dept1 = statistics.index(rowOf(statistics, "dept-1"));
+    EXPECT_EQ(statistics.data(dept1, SalaryStatisticsModel::CountRole).toInt(), 3);
+    EXPECT_DOUBLE_EQ(statistics.data(dept1, SalaryStatisticsModel::P50Role).toDouble(), 60000);
+    EXPECT_NEAR(statistics.data(dept1, SalaryStatisticsModel::VarianceRole).toDouble(),
+                5.6e9 / 9, 1e-3);
+    QVariantList histogram =
+        statistics.data(dept1, SalaryStatisticsModel::HistogramRole).toList();
+    ASSERT_EQ(histogram.size(), SalaryStatisticsModel::DefaultBinCount);
+    EXPECT_EQ(histogram.first().toInt(), 1);
+    EXPECT_EQ(histogram.last().toInt(), 1);
+
+    statistics.setGroupBy(SalaryStatisticsModel::BySalaryGrade);
+    ASSERT_EQ(statistics.rowCount(), 3);
+    QModelIndex grade3 = statistics.index(rowOf(statistics, "grade-3"));
+    EXPECT_EQ(statistics.data(grade3, SalaryStatisticsModel::NameRole).toString(), "E3");
+    EXPECT_EQ(statistics.data(grade3, SalaryStatisticsModel::CountRole).toInt(), 2);
+}
+
+TEST(SalaryStatisticsModelTest, WhatIfSalaryAppliesImmediately) {
+    SalaryGradeListModel grades;
+    grades.setItems({makeGrade("grade-1", "E1", 40000), makeGrade("grade-2", "E2", 60000)});
+    EmployeeListModel employees;
+    employees.setItems({makeGradedEmployee("emp-1", "dept-1", "grade-1"),
+                        makeGradedEmployee("emp-2", "dept-1", "grade-2")});
+    SalaryStatisticsModel statistics;
+    statistics.setEmployeeModel(&employees);
+    statistics.setSalaryGradeModel(&grades);
+    statistics.recompute();
+    QSignalSpy changedSpy(&statistics, &SalaryStatisticsModel::statisticsChanged);
+
+    // No event loop needed, so a dialog can preview every keystroke
+    statistics.setWhatIfSalary("grade-1", 80000);
+    EXPECT_EQ(changedSpy.count(), 1);
+    EXPECT_TRUE(statistics.whatIfActive());
+    EXPECT_DOUBLE_EQ(statistics.organizationDistribution().mean, 70000);
+    EXPECT_DOUBLE_EQ(statistics.organizationDistribution().max, 80000);
+    // The grade itself is untouched
+    EXPECT_EQ(grades.itemById("grade-1")->baseSalary, 40000);
+
+    statistics.clearWhatIf();
+    EXPECT_FALSE(statistics.whatIfActive());
+    EXPECT_DOUBLE_EQ(statistics.organizationDistribution().mean, 50000);
+
+    // Changes to the real data are picked up on the next pass of the event loop
+    grades.upsert(makeGrade("grade-2", "E2", 100000));
+    ASSERT_TRUE(changedSpy.wait());
+    EXPECT_DOUBLE_EQ(statistics.organizationDistribution().mean, 70000);
+}
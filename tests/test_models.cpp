@@ -1,13 +1,20 @@
+#include "models/compactemployee.h"
 #include "models/department.h"
 #include "models/employee.h"
+#include "models/isodatetime.h"
+#include "models/salarydistribution.h"
 #include "models/salarygrade.h"
 
 #include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QStringList>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 // ============================================================================
 // Employee Tests
 // ============================================================================
@@ -174,6 +181,15 @@ TEST_F(DepartmentTest, ToJson) {
     EXPECT_EQ(json["head_id"].toString(), "emp-456");
 }
 
+TEST_F(DepartmentTest, ToRestoreJsonNamesMissingHead) {
+    EXPECT_EQ(testDepartment.toRestoreJson()["head_id"].toString(), "emp-456");
+
+    QJsonObject json = Department("dept-888", "Sales").toRestoreJson();
+    EXPECT_EQ(json["name"].toString(), "Sales");
+    ASSERT_TRUE(json.contains("head_id"));
+    EXPECT_TRUE(json["head_id"].isNull());
+}
+
 TEST_F(DepartmentTest, FromJson) {
     QJsonObject json;
     json["id"] = "dept-777";
@@ -316,6 +332,207 @@ TEST_F(SalaryGradeTest, HandleLargeSalary) {
     EXPECT_DOUBLE_EQ(grade2.baseSalary, 999999.99);
 }
 
+// ============================================================================
+// CompactEmployee Tests
+// ============================================================================
+
+namespace {
+
+Employee fullEmployee() {
+    Employee emp;
+    emp.id = "3f2b8c1e-9a4d-4e6f-8b21-0c5d7e9f1a2b";
+    emp.firstName = "Grace";
+    emp.lastName = "Hopper";
+    emp.email = "grace@example.com";
+    emp.role = "DepartmentHead";
+    emp.active = false;
+    emp.departmentId = "9e1d2c3b-4a5f-4678-9abc-def012345678";
+    emp.managerId = "legacy-42";                            // Not a UUID
+    emp.salaryGradeId = "3F2B8C1E-9A4D-4E6F-8B21-0C5D7E9F1A2B"; // Not canonical
+    emp.hireDate = QDateTime::fromString("2019-04-01", Qt::ISODate);
+    emp.createdAt = QDateTime::fromString("2019-03-28T09:15:42.250Z", Qt::ISODate);
+    emp.updatedAt = QDateTime::fromString("2024-11-02T18:03:11+02:00", Qt::ISODate);
+    return emp;
+}
+
+} // namespace
+
+TEST(CompactEmployeeTest, RoundTripsEveryField) {
+    Employee original = fullEmployee();
+    CompactEmployee compact = CompactEmployee::fromEmployee(original);
+    Employee restored = compact.toEmployee();
+
+    EXPECT_EQ(restored, original);
+    EXPECT_EQ(restored.managerId, "legacy-42");
+    EXPECT_EQ(restored.salaryGradeId, original.salaryGradeId);
+    EXPECT_EQ(compact.firstNameString(), "Grace");
+    EXPECT_EQ(compact.lastNameString(), "Hopper");
+    EXPECT_EQ(compact.emailString(), "grace@example.com");
+    // Same spec and offset, not just the same instant
+    EXPECT_EQ(restored.hireDate.toString(Qt::ISODateWithMs),
+              original.hireDate.toString(Qt::ISODateWithMs));
+    EXPECT_EQ(restored.createdAt.toString(Qt::ISODateWithMs),
+              original.createdAt.toString(Qt::ISODateWithMs));
+    EXPECT_EQ(restored.updatedAt.toString(Qt::ISODateWithMs),
+              original.updatedAt.toString(Qt::ISODateWithMs));
+    EXPECT_FALSE(restored.deletedAt.isValid());
+    EXPECT_EQ(compact.epochMs(CompactEmployee::DeletedAt), CompactEmployee::NoTime);
+
+    Employee empty;
+    EXPECT_EQ(CompactEmployee::fromEmployee(empty).toEmployee(), empty);
+}
+
+TEST(CompactEmployeeTest, KeepsCanonicalUuidsInBinary) {
+    Employee emp = fullEmployee();
+    CompactEmployee compact = CompactEmployee::fromEmployee(emp);
+
+    EXPECT_TRUE(compact.id.isUuid());
+    EXPECT_TRUE(compact.departmentId.isUuid());
+    EXPECT_FALSE(compact.managerId.isUuid());
+    EXPECT_FALSE(compact.salaryGradeId.isUuid());
+    EXPECT_TRUE(CompactId().isNull());
+    EXPECT_TRUE(CompactId::fromString(QString()).isNull());
+
+    // Parsing again gives an equal id, and the upper-case spelling stays distinct
+    EXPECT_EQ(CompactId::fromString(emp.id), compact.id);
+    EXPECT_EQ(CompactId::fromString("legacy-42"), compact.managerId);
+    EXPECT_NE(compact.id, compact.salaryGradeId);
+    EXPECT_EQ(compact.id.toString(), emp.id);
+}
+
+TEST(CompactEmployeeTest, InternsRolesAndComparesLikeEmployee) {
+    Employee first = fullEmployee();
+    Employee second = fullEmployee();
+    second.id = "0a1b2c3d-4e5f-4a6b-8c7d-8e9fa0b1c2d3";
+
+    CompactEmployee a = CompactEmployee::fromEmployee(first);
+    CompactEmployee b = CompactEmployee::fromEmployee(second);
+    EXPECT_EQ(a.role, b.role);
+    EXPECT_EQ(a.roleString(), "DepartmentHead");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, CompactEmployee::fromEmployee(first));
+
+    // Same characters split differently between the names
+    Employee split = first;
+    split.firstName = "Grac";
+    split.lastName = "eHopper";
+    EXPECT_NE(CompactEmployee::fromEmployee(split), a);
+}
+
+// ============================================================================
+// Salary Distribution Tests
+// ============================================================================
+
+TEST(SalaryDistributionTest, SummarizesValues) {
+    QList<double> values = {7, 3, 10, 1, 5, 9, 2, 8, 4, 6};
+    SalaryDistribution distribution = SalaryDistribution::of(values.data(), values.size());
+
+    EXPECT_EQ(distribution.count, 10);
+    EXPECT_DOUBLE_EQ(distribution.mean, 5.5);
+    EXPECT_DOUBLE_EQ(distribution.variance, 8.25);
+    EXPECT_DOUBLE_EQ(distribution.min, 1);
+    EXPECT_DOUBLE_EQ(distribution.max, 10);
+    // Interpolated between the closest ranks
+    EXPECT_DOUBLE_EQ(distribution.p10, 1.9);
+    EXPECT_DOUBLE_EQ(distribution.p50, 5.5);
+    EXPECT_DOUBLE_EQ(distribution.p90, 9.1);
+
+    EXPECT_EQ(SalaryDistribution::of(nullptr, 0).count, 0);
+    double single = 42;
+    SalaryDistribution one = SalaryDistribution::of(&single, 1);
+    EXPECT_DOUBLE_EQ(one.p10, 42);
+    EXPECT_DOUBLE_EQ(one.p90, 42);
+    EXPECT_DOUBLE_EQ(one.variance, 0);
+}
+
+TEST(SalaryDistributionTest, PercentilesMatchSortedRanks) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> salary(30000, 150000);
+    QList<double> values(1001);
+    for (double& value : values)
+        value = salary(random);
+    QList<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double fractions[] = {0.0, 0.1, 0.25, 0.5, 0.9, 1.0};
+    double results[6];
+    SalaryDistribution::percentiles(values.data(), values.size(), fractions, 6, results);
+    // 1001 values put every one of these fractions exactly on a rank
+    EXPECT_DOUBLE_EQ(results[0], sorted.first());
+    EXPECT_DOUBLE_EQ(results[1], sorted.at(100));
+    EXPECT_DOUBLE_EQ(results[2], sorted.at(250));
+    EXPECT_DOUBLE_EQ(results[3], sorted.at(500));
+    EXPECT_DOUBLE_EQ(results[4], sorted.at(900));
+    EXPECT_DOUBLE_EQ(results[5], sorted.last());
+}
+
+TEST(SalaryDistributionTest, HistogramClampsToRange) {
+    const double values[] = {0, 1, 2.5, 5, 9.99, 10, 12, -3};
+    EXPECT_EQ(SalaryDistribution::histogram(values, 8, 0, 10, 4), QList<int>({3, 1, 1, 3}));
+    // Without a spread everything lands in the first bin
+    EXPECT_EQ(SalaryDistribution::histogram(values, 2, 5, 5, 3), QList<int>({2, 0, 0}));
+}
+
+// ============================================================================
+// Timestamp Parsing Tests
+// ============================================================================
+
+namespace {
+
+// Same instant, and the same spec and offset, so toString() round-trips identically
+void expectSameAsQt(const QString& text) {
+    SCOPED_TRACE(text.toStdString());
+    QDateTime expected = QDateTime::fromString(text, Qt::ISODate);
+    QDateTime parsed = parseIsoDateTime(text);
+    ASSERT_EQ(parsed.isValid(), expected.isValid());
+    if (!expected.isValid())
+        return;
+    EXPECT_EQ(parsed, expected);
+    EXPECT_EQ(parsed.timeSpec(), expected.timeSpec());
+    EXPECT_EQ(parsed.offsetFromUtc(), expected.offsetFromUtc());
+    EXPECT_EQ(parsed.toString(Qt::ISODateWithMs), expected.toString(Qt::ISODateWithMs));
+}
+
+} // namespace
+
+TEST(IsoDateTimeTest, ParsesServerFormats) {
+    QDateTime utc = parseIsoDateTime(QStringLiteral("2024-01-15T10:30:00.123456Z"));
+    EXPECT_EQ(utc.timeSpec(), Qt::UTC);
+    EXPECT_EQ(utc.date(), QDate(2024, 1, 15));
+    EXPECT_EQ(utc.time(), QTime(10, 30, 0, 123));
+
+    QDateTime offset = parseIsoDateTime(QStringLiteral("2024-01-15T12:30:00-02:30"));
+    EXPECT_EQ(offset.offsetFromUtc(), -9000);
+    EXPECT_EQ(offset.toUTC(), QDateTime(QDate(2024, 1, 15), QTime(15, 0), Qt::UTC));
+
+    QDateTime dateOnly = parseIsoDateTime(QStringLiteral("2019-04-01"));
+    EXPECT_EQ(dateOnly.date(), QDate(2019, 4, 1));
+    EXPECT_EQ(dateOnly.time(), QTime(0, 0));
+}
+
+TEST(IsoDateTimeTest, MatchesQtParsing) {
+    const QStringList inputs = {
+        // Fast path
+        "2024-01-15T10:30:00Z", "2024-01-15T10:30:00.5Z", "2024-01-15T10:30:00.9996Z",
+        "2024-01-15T10:30:00.123456789+05:45", "2024-01-15T10:30:00+00:00",
+        "2024-01-15T10:30:00", "2024-02-29", "1970-01-01T00:00:00Z",
+        // Left to Qt
+        "2024-01-15 10:30:00", "2024-01-15T10:30Z", "2024-01-15T24:00:00Z",
+        "2024-01-15T10:30:00+0200", "2024-01-15T10:30:00,25Z",
+        // Invalid either way
+        "", "2024-02-30", "2023-13-01T00:00:00Z", "2024-01-15T25:00:00Z", "2024-01-15T",
+        "2024-01-15T10:30:00.Z", "2024-01-15T10:30:00Zjunk", "not a timestamp"};
+    for (const QString& input : inputs)
+        expectSameAsQt(input);
+}
+
+TEST(IsoDateTimeTest, MissingOrNullJsonValueIsInvalid) {
+    QJsonObject json{{"deleted_at", QJsonValue()}, {"created_at", 42}};
+    EXPECT_FALSE(parseIsoDateTime(json.value("deleted_at")).isValid());
+    EXPECT_FALSE(parseIsoDateTime(json.value("created_at")).isValid());
+    EXPECT_FALSE(parseIsoDateTime(json.value("updated_at")).isValid());
+}
+
 // ============================================================================
 // Edge Cases and Integration Tests
 // ============================================================================
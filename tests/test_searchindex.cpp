@@ -0,0 +1,115 @@
+#include "models/employeesearchindex.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+Employee makeEmployee(const QString& id, const QString& first, const QString& last,
+                      const QString& role = "Employee") {
+    Employee emp;
+    emp.id = id;
+    emp.firstName = first;
+    emp.lastName = last;
+    emp.email = first.toLower() + "." + last.toLower() + "@example.com";
+    emp.role = role;
+    return emp;
+}
+
+QStringList idsOf(const QList<EmployeeSearchIndex::Hit>& hits) {
+    QStringList ids;
+    for (const EmployeeSearchIndex::Hit& hit : hits)
+        ids.append(hit.id);
+    return ids;
+}
+
+} // namespace
+
+TEST(EmployeeSearchIndexTest, MatchesSubstringsOfEveryField) {
+    EmployeeSearchIndex index;
+    index.insert(makeEmployee("emp-1", "John", "Doe", "Engineer"), "Research");
+    index.insert(makeEmployee("emp-2", "Jane", "Roe", "Accountant"), "Finance");
+
+    EXPECT_EQ(idsOf(index.search("OHN")), QStringList{"emp-1"});
+    EXPECT_EQ(idsOf(index.search("jane.roe@")), QStringList{"emp-2"});
+    EXPECT_EQ(idsOf(index.search("gineer")), QStringList{"emp-1"});
+    EXPECT_EQ(idsOf(index.search("finance")), QStringList{"emp-2"});
+    EXPECT_TRUE(index.search("xyz").isEmpty());
+    EXPECT_TRUE(index.search("   ").isEmpty());
+}
+
+TEST(EmployeeSearchIndexTest, ShortQueriesScanAllEntries) {
+    EmployeeSearchIndex index;
+    index.insert(makeEmployee("emp-1", "John", "Doe"), QString());
+    index.insert(makeEmployee("emp-2", "Jane", "Roe"), QString());
+
+    EXPECT_EQ(idsOf(index.search("j")).size(), 2);
+    EXPECT_EQ(idsOf(index.search("oe")).size(), 2);
+    EXPECT_EQ(idsOf(index.search("jo")), QStringList{"emp-1"});
+}
+
+TEST(EmployeeSearchIndexTest, TrigramsMustOccurTogether) {
+    EmployeeSearchIndex index;
+    // Contains every trigram of "anna" spread over two fields, but not the string itself
+    index.insert(makeEmployee("emp-1", "Ann", "Nna"), QString());
+
+    EXPECT_TRUE(index.search("anna").isEmpty());
+}
+
+TEST(EmployeeSearchIndexTest, RanksNamePrefixFirst) {
+    EmployeeSearchIndex index;
+    index.insert(makeEmployee("emp-1", "Mark", "Stone", "Marketing lead"), QString());
+    index.insert(makeEmployee("emp-2", "Anna", "Marks"), QString());
+    index.insert(makeEmployee("emp-3", "Marko", "Polo"), QString());
+    index.insert(makeEmployee("emp-4", "Lou", "Smith", "Analyst"), "Marketing");
+
+    QList<EmployeeSearchIndex::Hit> hits = index.search("mark");
+    EXPECT_EQ(idsOf(hits), (QStringList{"emp-1", "emp-3", "emp-2", "emp-4"}));
+    EXPECT_LT(hits.at(1).rank, hits.at(2).rank);
+    EXPECT_LT(hits.at(2).rank, hits.at(3).rank);
+}
+
+TEST(EmployeeSearchIndexTest, UpdatesAndRemovesEntries) {
+    EmployeeSearchIndex index;
+    index.insert(makeEmployee("emp-1", "John", "Doe"), "Sales");
+    index.insert(makeEmployee("emp-1", "Johnny", "Doe"), "Support");
+
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(index.departmentNameOf("emp-1"), "support");
+    EXPECT_TRUE(index.search("sales").isEmpty());
+    EXPECT_EQ(idsOf(index.search("johnny")), QStringList{"emp-1"});
+
+    index.remove("emp-1");
+    EXPECT_FALSE(index.contains("emp-1"));
+    EXPECT_TRUE(index.search("johnny").isEmpty());
+}
+
+TEST(EmployeeSearchIndexTest, CompactsAfterManyRemovals) {
+    EmployeeSearchIndex index;
+    for (int i = 0; i < 3000; ++i)
+        index.insert(makeEmployee(QString("emp-%1").arg(i), "Person", QString::number(i)),
+                     QString());
+    for (int i = 0; i < 2990; ++i)
+        index.remove(QString("emp-%1").arg(i));
+
+    EXPECT_EQ(index.size(), 10);
+    EXPECT_EQ(index.search("person").size(), 10);
+    EXPECT_EQ(idsOf(index.search("2995")), QStringList{"emp-2995"});
+}
+
+TEST(EmployeeSearchIndexTest, TopMatchesKeepsBestRankedByName) {
+    EmployeeSearchIndex index;
+    index.insert(makeEmployee("emp-1", "Mark", "Stone"), QString());
+    index.insert(makeEmployee("emp-2", "Anna", "Marks"), QString());
+    index.insert(makeEmployee("emp-3", "Maria", "Lopez"), QString());
+    index.insert(makeEmployee("emp-4", "Marco", "Polo"), QString());
+
+    EXPECT_EQ(idsOf(index.topMatches("mar", 2)), (QStringList{"emp-4", "emp-3"}));
+    EXPECT_EQ(idsOf(index.topMatches("mar", -1)),
+              (QStringList{"emp-4", "emp-3", "emp-1", "emp-2"}));
+
+    // Everything matches an empty query, in name order
+    EXPECT_EQ(idsOf(index.topMatches("", 1)), QStringList{"emp-2"});
+
+    auto notMarco = [](const QString& id) { return id != "emp-4"; };
+    EXPECT_EQ(idsOf(index.topMatches("mar", 1, notMarco)), QStringList{"emp-3"});
+}
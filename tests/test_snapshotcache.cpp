@@ -0,0 +1,90 @@
+#include "api/snapshotcache.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+class SnapshotCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_dir.isValid());
+
+        Employee emp;
+        emp.id = "emp-1";
+        emp.firstName = "John";
+        emp.lastName = "Doe";
+        emp.email = "john@example.com";
+        emp.active = false;
+        emp.departmentId = "dept-1";
+        emp.hireDate = QDateTime::fromString("2024-01-15T00:00:00Z", Qt::ISODate);
+
+        SalaryGrade grade;
+        grade.id = "grade-1";
+        grade.code = "E3";
+        grade.baseSalary = 65000.5;
+
+        m_snapshot.departments = {Department("dept-1", "Engineering", "emp-1")};
+        m_snapshot.employees = {emp};
+        m_snapshot.salaryGrades = {grade};
+    }
+
+    QString path() const { return m_dir.filePath("cache/snapshot.bin"); }
+
+    QTemporaryDir m_dir;
+    Snapshot m_snapshot;
+};
+
+TEST_F(SnapshotCacheTest, RoundTripsAllCollections) {
+    SnapshotCache cache(path());
+    ASSERT_TRUE(cache.save(m_snapshot));
+
+    Snapshot loaded;
+    ASSERT_TRUE(cache.load(loaded));
+    EXPECT_EQ(loaded.departments, m_snapshot.departments);
+    EXPECT_EQ(loaded.employees, m_snapshot.employees);
+    EXPECT_EQ(loaded.salaryGrades, m_snapshot.salaryGrades);
+}
+
+TEST_F(SnapshotCacheTest, RejectsCorruptedPayload) {
+    SnapshotCache cache(path());
+    ASSERT_TRUE(cache.save(m_snapshot));
+
+    QFile file(path());
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    file.seek(file.size() - 1);
+    char last = 0;
+    file.getChar(&last);
+    file.seek(file.size() - 1);
+    file.putChar(static_cast<char>(~last));
+    file.close();
+
+    Snapshot loaded;
+    EXPECT_FALSE(cache.load(loaded));
+}
+
+TEST_F(SnapshotCacheTest, RejectsOtherFormatVersion) {
+    SnapshotCache cache(path());
+    ASSERT_TRUE(cache.save(m_snapshot));
+
+    // The version follows the 4 byte magic, big-endian
+    QFile file(path());
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    file.seek(7);
+    file.write(QByteArray(1, static_cast<char>(SnapshotCache::FormatVersion + 1)));
+    file.close();
+
+    Snapshot loaded;
+    EXPECT_FALSE(cache.load(loaded));
+}
+
+TEST_F(SnapshotCacheTest, InvalidateRemovesSnapshot) {
+    SnapshotCache cache(path());
+    ASSERT_TRUE(cache.save(m_snapshot));
+
+    cache.invalidate();
+
+    Snapshot loaded;
+    EXPECT_FALSE(QFile::exists(path()));
+    EXPECT_FALSE(cache.load(loaded));
+}